@@ -0,0 +1,252 @@
+#ifndef BETWEENNESS_HPP
+#define BETWEENNESS_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+#include "ShortestPath.hpp"
+#include "../Tree/IndexedPriorityQueue.hpp"
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+
+/**
+ * @file Betweenness.hpp
+ * @brief 介数中心性(betweenness centrality)，Brandes 算法按源点并行，运行在 CSRGraph / MappedGraph / CompressedGraph 上。
+ *
+ * C(v) = sum_{s != v != t} sigma_st(v) / sigma_st，sigma_st 为 s 到 t 的最短路条数，sigma_st(v) 为其中经过 v 的条数。
+ *
+ * 1. betweenness_centrality(g, options):
+ *    - 无权版本：每个源点做一次 BFS 求 dist 与 sigma，再按出栈逆序累加依赖
+ *      delta(w) = sum_{w -> v, dist(v) = dist(w) + 1} sigma(w) / sigma(v) * (1 + delta(v))，
+ *      依赖只沿出边向后继回溯，不需要前驱表，有向图也不要求维护入边。
+ *
+ * 2. weighted_betweenness_centrality(g, weight, options):
+ *    - 带权版本：BFS 换成 IndexedPriorityQueue 上的 Dijkstra，后继条件为 dist(v) = dist(w) + w(w, v) 且 v 比 w 后出堆；
+ *      正向与反向用同一个表达式计算 dist(w) + w，浮点边权下判等也是精确的。
+ *    - 边权不能为负；零权边只在端点的出堆顺序与边方向一致时计入，等长路径经零权环时的计数不保证精确。
+ *
+ * 并行方式：源点分块交给各线程，每个线程持有自己的 dist/sigma/delta 工作区和一份长度为 n 的累加数组，
+ * 结束后按顶点并行归约，计算过程中没有任何共享写。工作区每轮只重置本次访问到的顶点。
+ *
+ * 抽样近似：options.samples = k > 0 时不放回地随机抽取 k 个源点，估计值为 n / k * sum delta_s(v)。
+ * 每个源点的贡献 delta_s(v) 落在 [0, n - 2] 中，由 Hoeffding 不等式(对不放回抽样同样成立)加上对 n 个顶点的并集界，
+ * 以 options.confidence 的概率所有顶点同时满足 |估计 - 精确| <= n (n - 2) sqrt(ln(2n / (1 - confidence)) / 2k)，
+ * 该界记在结果的 error_bound 中；betweenness_samples() 反过来由目标误差求所需的 k。
+ *
+ * 无向图上每对 {s, t} 被两个方向各统计一次，结果除以 2。重复边按条数计入最短路条数，自环不影响结果。
+ * normalized 时有向图除以 (n - 1)(n - 2)，无向图除以 (n - 1)(n - 2) / 2，取值落在 [0, 1]。
+ */
+
+struct BetweennessOptions {
+    bool normalized = false;
+    std::size_t samples = 0;        // 0 为精确计算，否则为抽样的源点数(>= n 时退化为精确计算)
+    double confidence = 0.95;       // 抽样误差界成立的概率
+    std::uint64_t seed = 1;
+    unsigned threads = hardware_threads();
+};
+
+struct BetweennessResult {
+    std::vector<double> centrality;
+    std::size_t sources;    // 实际使用的源点数
+    double error_bound;     // 以 confidence 的概率对所有顶点成立的绝对误差上界，精确计算为 0
+};
+
+// 归一化误差不超过 epsilon(概率至少 confidence)所需的抽样源点数
+inline std::size_t betweenness_samples(std::size_t n, double epsilon, double confidence = 0.95){
+    if (n < 3) return n;
+    if (!(epsilon > 0) || !(confidence > 0 && confidence < 1)) throw std::invalid_argument("betweenness_samples(): 参数越界!");
+    double scale = static_cast<double>(n) / static_cast<double>(n - 1);
+    double k = std::ceil(scale * scale * std::log(2.0 * static_cast<double>(n) / (1 - confidence)) / (2 * epsilon * epsilon));
+    return k >= static_cast<double>(n) ? n : static_cast<std::size_t>(k);
+}
+
+// 单个线程的 Brandes 工作区，dist 为 W 的 max 表示未访问
+template<typename IdType, typename W>
+struct BrandesWorkspace {
+    static constexpr W inf = std::numeric_limits<W>::max();
+
+    std::vector<W> dist;
+    std::vector<double> sigma;
+    std::vector<double> delta;
+    std::vector<IdType> order;          // 按出队(出堆)顺序排列的可达顶点
+    std::vector<IdType> rank;           // 带权版本：顶点在 order 中的位置
+    IndexedPriorityQueue<W> heap;
+    std::vector<double> centrality;     // 本线程的累加数组
+
+    explicit BrandesWorkspace(std::size_t n, bool weighted)
+        : dist(n, inf), sigma(n, 0), delta(n, 0), centrality(n, 0) {
+        order.reserve(n);
+        if (weighted) {
+            rank.resize(n);
+            heap.resize(n);
+        }
+    }
+
+    void reset(){
+        for (IdType v : order) {
+            dist[v] = inf;
+            sigma[v] = 0;
+            delta[v] = 0;
+        }
+        order.clear();
+    }
+};
+
+template<typename CSR>
+void brandes_bfs(const CSR& g, typename CSR::id_type s, BrandesWorkspace<typename CSR::id_type, std::uint64_t>& ws){
+    using id_type = typename CSR::id_type;
+    ws.reset();
+    ws.dist[s] = 0;
+    ws.sigma[s] = 1;
+    ws.order.emplace_back(s);
+    for (std::size_t head = 0; head < ws.order.size(); ++head) {
+        id_type u = ws.order[head];
+        std::uint64_t next = ws.dist[u] + 1;
+        for (id_type v : g.out_neighbors(u)) {
+            if (ws.dist[v] == ws.inf) {
+                ws.dist[v] = next;
+                ws.order.emplace_back(v);
+            }
+            if (ws.dist[v] == next) ws.sigma[v] += ws.sigma[u];
+        }
+    }
+    for (std::size_t i = ws.order.size(); i-- > 1; ) {
+        id_type w = ws.order[i];
+        std::uint64_t next = ws.dist[w] + 1;
+        double acc = 0;
+        for (id_type v : g.out_neighbors(w)) {
+            if (ws.dist[v] == next) acc += (1 + ws.delta[v]) / ws.sigma[v];
+        }
+        ws.delta[w] = ws.sigma[w] * acc;
+        ws.centrality[w] += ws.delta[w];
+    }
+}
+
+template<typename CSR, typename WeightFn, typename W>
+void brandes_dijkstra(const CSR& g, typename CSR::id_type s, WeightFn& weight, BrandesWorkspace<typename CSR::id_type, W>& ws){
+    using id_type = typename CSR::id_type;
+    ws.reset();
+    ws.heap.clear();
+    ws.dist[s] = 0;
+    ws.sigma[s] = 1;
+    ws.heap.push(s, 0);
+    while (!ws.heap.isEmpty()) {
+        id_type u = static_cast<id_type>(ws.heap.getTopIndex());
+        ws.heap.pop();
+        ws.rank[u] = static_cast<id_type>(ws.order.size());
+        ws.order.emplace_back(u);
+        W du = ws.dist[u];
+        auto prop = g.out_edge_props(u).begin();
+        for (id_type v : g.out_neighbors(u)) {
+            W nd = du + weight(*prop++);
+            if (v == u) continue;
+            if (nd < ws.dist[v]) {
+                // 未出堆的顶点才可能被更新：已出堆顶点的 dist <= du <= nd
+                ws.dist[v] = nd;
+                ws.sigma[v] = ws.sigma[u];
+                ws.heap.pushOrDecrease(v, nd);
+            } else if (nd == ws.dist[v] && ws.heap.contains(v)) {
+                ws.sigma[v] += ws.sigma[u];
+            }
+        }
+    }
+    for (std::size_t i = ws.order.size(); i-- > 1; ) {
+        id_type w = ws.order[i];
+        W dw = ws.dist[w];
+        double acc = 0;
+        auto prop = g.out_edge_props(w).begin();
+        for (id_type v : g.out_neighbors(w)) {
+            const auto& p = *prop++;
+            if (ws.dist[v] != ws.inf && ws.rank[v] > ws.rank[w] && ws.dist[v] == dw + weight(p)) {
+                acc += (1 + ws.delta[v]) / ws.sigma[v];
+            }
+        }
+        ws.delta[w] = ws.sigma[w] * acc;
+        ws.centrality[w] += ws.delta[w];
+    }
+}
+
+// 按 options 选出源点，分块并行执行 single_source(s, ws)，归约并缩放
+template<typename IdType, typename W, typename SingleSource>
+BetweennessResult brandes_run(std::size_t n, bool undirected, bool weighted, const BetweennessOptions& options, SingleSource single_source){
+    BetweennessResult result{std::vector<double>(n, 0), 0, 0};
+    if (n == 0) return result;
+    unsigned threads = options.threads == 0 ? 1 : options.threads;
+
+    std::vector<IdType> sources;
+    bool sampled = options.samples > 0 && options.samples < n;
+    if (sampled) {
+        if (!(options.confidence > 0 && options.confidence < 1)) throw std::invalid_argument("betweenness: confidence 必须落在 (0, 1) 中!");
+        // 部分 Fisher-Yates：不放回地抽取 samples 个源点
+        std::vector<IdType> perm(n);
+        std::iota(perm.begin(), perm.end(), IdType(0));
+        std::mt19937_64 rng(options.seed);
+        for (std::size_t i = 0; i < options.samples; ++i) {
+            std::uniform_int_distribution<std::size_t> pick(i, n - 1);
+            std::swap(perm[i], perm[pick(rng)]);
+        }
+        sources.assign(perm.begin(), perm.begin() + options.samples);
+    } else {
+        sources.resize(n);
+        std::iota(sources.begin(), sources.end(), IdType(0));
+    }
+    result.sources = sources.size();
+
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, sources.size()));
+    std::vector<std::unique_ptr<BrandesWorkspace<IdType, W>>> workspaces(threads);
+    parallel_for(sources.size(), threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+        if (!workspaces[tid]) workspaces[tid] = std::make_unique<BrandesWorkspace<IdType, W>>(n, weighted);
+        for (std::size_t i = begin; i < end; ++i) single_source(sources[i], *workspaces[tid]);
+    }, 16);
+
+    double scale = sampled ? static_cast<double>(n) / static_cast<double>(sources.size()) : 1.0;
+    if (undirected) scale /= 2;
+    if (options.normalized && n > 2) scale /= static_cast<double>(n - 1) * static_cast<double>(n - 2) / (undirected ? 2 : 1);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t v = begin; v < end; ++v) {
+            double sum = 0;
+            for (const auto& ws : workspaces) if (ws) sum += ws->centrality[v];
+            result.centrality[v] = sum * scale;
+        }
+    }, 4096);
+
+    if (sampled && n > 2) {
+        double k = static_cast<double>(sources.size());
+        double per_source = static_cast<double>(n - 2) * std::sqrt(std::log(2.0 * static_cast<double>(n) / (1 - options.confidence)) / (2 * k));
+        result.error_bound = per_source * k * scale; // 与估计值使用相同的缩放
+    }
+    return result;
+}
+
+template<typename CSR>
+BetweennessResult betweenness_centrality(const CSR& g, const BetweennessOptions& options = {}){
+    using id_type = typename CSR::id_type;
+    return brandes_run<id_type, std::uint64_t>(g.num_nodes(), CSR::direction == EdgeDirection::UNDIRECTED, false, options,
+        [&](id_type s, BrandesWorkspace<id_type, std::uint64_t>& ws){brandes_bfs(g, s, ws);});
+}
+
+template<typename CSR, typename WeightFn = IdentityWeight>
+BetweennessResult weighted_betweenness_centrality(const CSR& g, WeightFn weight = {}, const BetweennessOptions& options = {}){
+    using id_type = typename CSR::id_type;
+    using W = edge_weight_t<CSR, WeightFn>;
+    static_assert(std::is_arithmetic_v<W>, "边权必须是数值类型!");
+
+    // 工作线程中不能抛出异常，负权边在进入并行阶段前统一检查
+    std::atomic<bool> negative{false};
+    parallel_for(g.num_nodes(), options.threads == 0 ? 1 : options.threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t u = begin; u < end && !negative.load(std::memory_order_relaxed); ++u) {
+            for (const auto& p : g.out_edge_props(static_cast<id_type>(u))) {
+                if (weight(p) < W(0)) {
+                    negative.store(true, std::memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+    }, 4096);
+    if (negative.load()) throw std::invalid_argument("weighted_betweenness_centrality(): 存在负权边!");
+    return brandes_run<id_type, W>(g.num_nodes(), CSR::direction == EdgeDirection::UNDIRECTED, true, options,
+        [&](id_type s, BrandesWorkspace<id_type, W>& ws){brandes_dijkstra(g, s, weight, ws);});
+}
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef COMPRESSEDGRAPH_HPP
+#define COMPRESSEDGRAPH_HPP
+
+#include "Graph.hpp"
+#include <cstring>
+
+/**
+ * @file CompressedGraph.hpp
+ * @brief 差分 + 变长整数(varint)压缩的只读邻接表。
+ *
+ * CSR 中每个邻居固定占 4 字节；行内邻居有序时，相邻邻居的差值通常很小，用 LEB128 变长整数
+ * (每字节 7 位有效位，最高位表示后面还有字节)编码后多数只需 1~2 字节。每行的编码为:
+ *    zigzag(首个邻居 - u), 邻居[1] - 邻居[0], 邻居[2] - 邻居[1], ...
+ * 首项相对行号编码，重编号(见 Reorder.hpp)后局部性越好，压缩率越高；重复边的差值为 0。
+ *
+ * 1. out_neighbors / in_neighbors 返回惰性解码的前向区间 CompressedRange，支持 range-for、size()，
+ *    与 CSRGraph / MappedGraph 的只读接口一致，ParallelBFS、PageRank、TriangleCount 等可以直接运行在压缩图上。
+ * 2. decode_out_neighbors / decode_in_neighbors 把整行解码到缓冲区，一次检查 8 字节的续位，
+ *    8 个差值都是单字节时整块解码，适合需要随机访问邻居的内核。
+ * 3. 度由 arc_offsets 直接给出；边属性不压缩，仍按弧下标与邻居平行存放。
+ *
+ * 顶点 -> id 与 MappedGraph 一样在按键排序的 id 数组上二分，不再保存哈希表，NodeType 需要支持 operator<。
+ */
+
+// LEB128 变长整数
+inline void varint_encode(std::uint64_t x, std::vector<std::uint8_t>& out){
+    while (x >= 0x80) {
+        out.emplace_back(static_cast<std::uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    out.emplace_back(static_cast<std::uint8_t>(x));
+}
+
+inline std::uint64_t varint_decode(const std::uint8_t*& p) noexcept {
+    std::uint64_t x = *p & 0x7f;
+    unsigned shift = 7;
+    while (*p++ & 0x80) {
+        x |= static_cast<std::uint64_t>(*p & 0x7f) << shift;
+        shift += 7;
+    }
+    return x;
+}
+
+inline std::uint64_t zigzag_encode(std::int64_t x) noexcept {
+    return (static_cast<std::uint64_t>(x) << 1) ^ static_cast<std::uint64_t>(x >> 63);
+}
+
+inline std::int64_t zigzag_decode(std::uint64_t x) noexcept {
+    return static_cast<std::int64_t>(x >> 1) ^ -static_cast<std::int64_t>(x & 1);
+}
+
+// 惰性解码的一行邻居，只能前向遍历
+class CompressedRange {
+public:
+    using id_type = std::uint32_t;
+
+    class iterator {
+    private:
+        const std::uint8_t* p;
+        std::uint64_t remaining;
+        id_type current;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = id_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const id_type*;
+        using reference = id_type;
+
+        iterator(const std::uint8_t* p=nullptr, std::uint64_t count=0, id_type row=0) : p(p), remaining(count), current(0) {
+            if (remaining) current = static_cast<id_type>(static_cast<std::int64_t>(row) + zigzag_decode(varint_decode(this->p)));
+        }
+
+        id_type operator*() const noexcept {return current;}
+        iterator& operator++() noexcept {
+            if (--remaining) current += static_cast<id_type>(varint_decode(p));
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const iterator& other) const noexcept {return remaining == other.remaining;}
+        bool operator!=(const iterator& other) const noexcept {return remaining != other.remaining;}
+    };
+
+private:
+    const std::uint8_t* bytes;
+    std::uint64_t count;
+    id_type row;
+
+public:
+    CompressedRange(const std::uint8_t* bytes=nullptr, std::uint64_t count=0, id_type row=0) : bytes(bytes), count(count), row(row) {}
+
+    iterator begin() const noexcept {return iterator(bytes, count, row);}
+    iterator end() const noexcept {return iterator();}
+    std::size_t size() const noexcept {return static_cast<std::size_t>(count);}
+    bool empty() const noexcept {return count == 0;}
+};
+
+template<typename NodeType=int, typename NodePropType=void, typename EdgePropType=void,
+    EdgeDirection edge_direction=EdgeDirection::UNDIRECTED>
+class CompressedGraph{
+public:
+    using id_type = std::uint32_t;
+    using offset_type = std::uint64_t;
+    static constexpr id_type npos = std::numeric_limits<id_type>::max();
+    static constexpr offset_type npos_edge = std::numeric_limits<offset_type>::max();
+    static constexpr EdgeDirection direction = edge_direction;
+    using node_type = NodeType;
+    using node_prop_type = NodePropType;
+    using edge_prop_type = EdgePropType;
+
+    using NodePropColumn = std::conditional_t<std::is_void_v<NodePropType>, empty_node_prop, std::vector<NodePropType>>;
+    using EdgePropColumn = std::conditional_t<std::is_void_v<EdgePropType>, empty_edge_prop, std::vector<EdgePropType>>;
+
+private:
+    static_assert(is_less_comparable_v<NodeType>, "CompressedGraph 的顶点类型必须支持 operator<!");
+
+    // 一个方向的压缩邻接
+    struct Adjacency {
+        std::vector<offset_type> arc_offsets{0};  // 弧下标区间，同时给出度
+        std::vector<offset_type> byte_offsets{0}; // 编码区间
+        std::vector<std::uint8_t> bytes;          // 末尾补 8 个 0 字节，整块解码时不会越界
+        EdgePropColumn props;
+    };
+
+    std::vector<NodeType> id_to_node;
+    std::vector<id_type> sorted_ids;
+    Adjacency out_adj, in_adj; // in_adj 仅有向图使用
+    NodePropColumn node_props;
+    offset_type self_loops = 0;
+
+    template<typename Neighbors>
+    static void encode_row(id_type u, const Neighbors& neighbors, std::vector<std::uint8_t>& bytes){
+        bool first = true;
+        id_type prev = 0;
+        for (id_type v : neighbors) {
+            if (first) varint_encode(zigzag_encode(static_cast<std::int64_t>(v) - static_cast<std::int64_t>(u)), bytes);
+            else varint_encode(v - prev, bytes);
+            first = false;
+            prev = v;
+        }
+    }
+
+    template<typename G, bool reverse>
+    void encode(const G& g, Adjacency& adj){
+        const id_type n = g.num_nodes();
+        adj.arc_offsets.reserve(static_cast<std::size_t>(n) + 1);
+        adj.byte_offsets.reserve(static_cast<std::size_t>(n) + 1);
+        adj.bytes.reserve(g.num_arcs() + 8);
+        if constexpr (!std::is_void_v<EdgePropType>) adj.props.reserve(g.num_arcs());
+        for (id_type u = 0; u < n; ++u) {
+            auto neighbors = reverse ? g.in_neighbors(u) : g.out_neighbors(u);
+            encode_row(u, neighbors, adj.bytes);
+            adj.arc_offsets.emplace_back(adj.arc_offsets.back() + neighbors.size());
+            adj.byte_offsets.emplace_back(adj.bytes.size());
+            if constexpr (!std::is_void_v<EdgePropType>) {
+                for (auto& p : reverse ? g.in_edge_props(u) : g.out_edge_props(u)) adj.props.emplace_back(p);
+            }
+        }
+        adj.bytes.resize(adj.bytes.size() + 8, 0);
+        adj.bytes.shrink_to_fit();
+    }
+
+    static CompressedRange row(const Adjacency& adj, id_type u) {
+        return {adj.bytes.data() + adj.byte_offsets[u], adj.arc_offsets[u+1] - adj.arc_offsets[u], u};
+    }
+
+    static void decode_row(const Adjacency& adj, id_type u, std::vector<id_type>& out){
+        std::size_t count = static_cast<std::size_t>(adj.arc_offsets[u+1] - adj.arc_offsets[u]);
+        out.resize(count);
+        if (count == 0) return;
+        const std::uint8_t* p = adj.bytes.data() + adj.byte_offsets[u];
+        id_type cur = static_cast<id_type>(static_cast<std::int64_t>(u) + zigzag_decode(varint_decode(p)));
+        out[0] = cur;
+        std::size_t i = 1;
+        while (i < count) {
+            // 8 个续位都为 0：接下来的 8 个差值都是单字节
+            if (i + 8 <= count) {
+                std::uint64_t word;
+                std::memcpy(&word, p, sizeof(word));
+                if ((word & 0x8080808080808080ULL) == 0) {
+                    for (int k = 0; k < 8; ++k) out[i++] = cur += p[k];
+                    p += 8;
+                    continue;
+                }
+            }
+            out[i++] = cur += static_cast<id_type>(varint_decode(p));
+        }
+    }
+
+public:
+    CompressedGraph()=default;
+
+    // 由 CSRGraph / MappedGraph 等只读图构造，行内邻居须有序
+    template<typename G>
+    explicit CompressedGraph(const G& g){
+        static_assert(std::is_same_v<typename G::node_type, NodeType> && std::is_same_v<typename G::node_prop_type, NodePropType>
+            && std::is_same_v<typename G::edge_prop_type, EdgePropType> && G::direction == edge_direction, "源图的模板配置不一致!");
+        const id_type n = g.num_nodes();
+        id_to_node.reserve(n);
+        for (id_type u = 0; u < n; ++u) id_to_node.emplace_back(g.node_of(u));
+        sorted_ids.resize(n);
+        for (id_type u = 0; u < n; ++u) sorted_ids[u] = u;
+        std::sort(sorted_ids.begin(), sorted_ids.end(), [this](id_type a, id_type b){return id_to_node[a] < id_to_node[b];});
+        if constexpr (!std::is_void_v<NodePropType>) {
+            node_props.reserve(n);
+            for (id_type u = 0; u < n; ++u) node_props.emplace_back(g.node_prop(u));
+        }
+        encode<G, false>(g, out_adj);
+        if constexpr (direction == EdgeDirection::DIRECTED) encode<G, true>(g, in_adj);
+        self_loops = g.num_self_loops();
+    }
+
+    // 规模
+    id_type num_nodes() const noexcept {return static_cast<id_type>(id_to_node.size());}
+    offset_type num_arcs() const noexcept {return out_adj.arc_offsets.back();}
+    offset_type num_edges() const noexcept {
+        if constexpr (direction == EdgeDirection::UNDIRECTED) return (num_arcs() + self_loops) / 2;
+        else return num_arcs();
+    }
+    offset_type num_self_loops() const noexcept {return self_loops;}
+
+    // 邻接编码占用的字节数(不含 offsets)
+    std::size_t compressed_bytes() const noexcept {
+        std::size_t bytes = out_adj.bytes.size();
+        if constexpr (direction == EdgeDirection::DIRECTED) bytes += in_adj.bytes.size();
+        return bytes;
+    }
+
+    // 顶点与 id 互查
+    id_type id_of(const NodeType& node) const {
+        auto it = std::lower_bound(sorted_ids.begin(), sorted_ids.end(), node, [this](id_type id, const NodeType& key){return id_to_node[id] < key;});
+        return (it != sorted_ids.end() && !(node < id_to_node[*it])) ? *it : npos;
+    }
+    bool has_node(const NodeType& node) const {return id_of(node) != npos;}
+    const NodeType& node_of(id_type id) const {return id_to_node[id];}
+
+    // 度
+    offset_type out_degree(id_type u) const {return out_adj.arc_offsets[u+1] - out_adj.arc_offsets[u];}
+    offset_type in_degree(id_type u) const {
+        if constexpr (direction == EdgeDirection::DIRECTED) return in_adj.arc_offsets[u+1] - in_adj.arc_offsets[u];
+        else return out_degree(u);
+    }
+    offset_type degree(id_type u) const {
+        if constexpr (direction == EdgeDirection::DIRECTED) return out_degree(u) + in_degree(u);
+        else return out_degree(u);
+    }
+
+    // 邻居(惰性解码)
+    CompressedRange out_neighbors(id_type u) const {return row(out_adj, u);}
+    CompressedRange in_neighbors(id_type u) const {
+        if constexpr (direction == EdgeDirection::DIRECTED) return row(in_adj, u);
+        else return out_neighbors(u);
+    }
+
+    // 整行解码到 out
+    void decode_out_neighbors(id_type u, std::vector<id_type>& out) const {decode_row(out_adj, u, out);}
+    void decode_in_neighbors(id_type u, std::vector<id_type>& out) const {
+        if constexpr (direction == EdgeDirection::DIRECTED) decode_row(in_adj, u, out);
+        else decode_row(out_adj, u, out);
+    }
+
+    // 属性
+    template<typename P = EdgePropType>
+    CSRRange<P> out_edge_props(id_type u) const {
+        static_assert(!std::is_void_v<EdgePropType>,"此图不存在边属性!");
+        return {out_adj.props.data() + out_adj.arc_offsets[u], out_adj.props.data() + out_adj.arc_offsets[u+1]};
+    }
+    template<typename P = EdgePropType>
+    CSRRange<P> in_edge_props(id_type u) const {
+        static_assert(!std::is_void_v<EdgePropType>,"此图不存在边属性!");
+        if constexpr (direction == EdgeDirection::DIRECTED) return {in_adj.props.data() + in_adj.arc_offsets[u], in_adj.props.data() + in_adj.arc_offsets[u+1]};
+        else return out_edge_props(u);
+    }
+    template<typename P = NodePropType>
+    const P& node_prop(id_type u) const {
+        static_assert(!std::is_void_v<NodePropType>,"此图不存在顶点属性!");
+        return node_props[u];
+    }
+
+    // 查边：顺序解码该行，行内有序，越过 v 即可停止
+    offset_type edge_index(id_type u, id_type v) const {
+        offset_type e = out_adj.arc_offsets[u];
+        for (id_type w : out_neighbors(u)) {
+            if (w == v) return e;
+            if (v < w) break;
+            ++e;
+        }
+        return npos_edge;
+    }
+    bool has_edge(id_type u, id_type v) const {return edge_index(u, v) != npos_edge;}
+
+    // 解压成 CSRGraph
+    CSRGraph<NodeType, NodePropType, EdgePropType, edge_direction> to_csr() const {
+        using CSR = CSRGraph<NodeType, NodePropType, EdgePropType, edge_direction>;
+        std::vector<id_type> targets(num_arcs()), buf;
+        for (id_type u = 0; u < num_nodes(); ++u) {
+            decode_out_neighbors(u, buf);
+            std::copy(buf.begin(), buf.end(), targets.begin() + out_adj.arc_offsets[u]);
+        }
+        return CSR(id_to_node, out_adj.arc_offsets, std::move(targets), out_adj.props, node_props);
+    }
+};
+
+// 由只读图推导模板参数
+template<typename G>
+CompressedGraph<typename G::node_type, typename G::node_prop_type, typename G::edge_prop_type, G::direction> compress(const G& g){
+    return CompressedGraph<typename G::node_type, typename G::node_prop_type, typename G::edge_prop_type, G::direction>(g);
+}
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef CONCURRENTGRAPH_HPP
+#define CONCURRENTGRAPH_HPP
+
+#include "Graph.hpp"
+#include <memory>
+#include <mutex>
+
+/**
+ * @file ConcurrentGraph.hpp
+ * @brief 单写者发布、多读者并发读取的图，读者看到的是按版本(epoch)发布的不可变快照。
+ *
+ * 用一把全局互斥锁保护 Graph 时，每次 add_edge 都会挡住所有读者。ConcurrentGraph 把读写彻底分开：
+ *
+ * 1. 写入：add_node / add_edge / remove_* 只把操作追加到待发布的增量(delta)中，临界区只有一次 push_back，
+ *    多个写线程可以同时调用。
+ * 2. 发布：publish() 取走当前增量，按提交顺序应用到内部的 Graph(连续的加边操作合并为一次 add_edges 批量插入)，
+ *    再以上一个快照为基础增量冻结(Graph::freeze(previous, dirty, removed))，连同递增的 epoch 一起原子地替换当前快照。
+ *    同一时刻只有一个发布者，发布期间写线程仍可继续向新的增量追加操作，它们会进入下一个版本。
+ * 3. 读取：snapshot() 原子地取出当前快照的 shared_ptr，之后的遍历只读不可变的 CSR 数组，不需要任何锁；
+ *    持有快照的读者在新版本发布后仍看到一致的旧版本，最后一个持有者释放时旧版本才被回收。
+ *
+ * 发布的代价：增量涉及的行(加/删边的源点，无向图两端；删除顶点时还有指向它的行)从邻接表重建，哈希查找与这些行的
+ * 边数成正比；其余的行从上一个快照整段拷贝并重映射 id，是 O(V+E) 的顺序内存拷贝。快照是扁平的 CSRGraph，
+ * 以便所有 CSR 算法直接使用，因此每个版本都是一份完整的数组，发布期间新旧两个版本同时存在，峰值内存约为两份 CSR。
+ *
+ * 快照的替换使用 C++17 的 std::atomic_load / std::atomic_store(shared_ptr 重载)。在 libstdc++ 中它们通过一个全局的
+ * 自旋锁池实现，取快照本身并非无锁，但临界区只有一次指针与引用计数的拷贝，不会等待发布者的冻结；
+ * 取得快照之后的遍历完全无锁。切换到 C++20 后可直接换成 std::atomic<std::shared_ptr>。
+ * 写操作的返回值在发布时才能确定，因此写接口不返回插入/删除的条数。
+ */
+
+template<typename NodeType=int, typename NodePropType=void, typename EdgePropType=void,
+    EdgeDirection edge_direction=EdgeDirection::UNDIRECTED,
+    MultiEdge multi_edge=MultiEdge::DISALLOWED,
+    SelfLoop self_loop=SelfLoop::DISALLOWED,
+    Map adj_list_spec=Map::UNORDERED_MAP,
+    Container neighbors_container_spec=Container::UNORDERED_SET,
+    InEdgeIndex in_edge_index=InEdgeIndex::NONE>
+class ConcurrentGraph{
+public:
+    using Base = Graph<NodeType, NodePropType, EdgePropType, edge_direction, multi_edge, self_loop,
+        adj_list_spec, neighbors_container_spec, in_edge_index>;
+    using Frozen = typename Base::Frozen;
+
+    // 一个已发布的版本：epoch 单调递增，graph 永不修改
+    struct Version {
+        std::uint64_t epoch;
+        Frozen graph;
+    };
+    using Snapshot = std::shared_ptr<const Version>;
+
+private:
+    using NodePropArg = std::conditional_t<std::is_void_v<NodePropType>, empty_node_prop, NodePropType>;
+    using EdgePropArg = std::conditional_t<std::is_void_v<EdgePropType>, empty_edge_prop, EdgePropType>;
+
+    enum class OpKind {ADD_NODE, ADD_NODE_WITH_PROP, ADD_EDGE, ADD_EDGE_WITH_PROP, REMOVE_NODE, REMOVE_EDGE, REMOVE_EDGE_WITH_PROP};
+
+    struct Op {
+        OpKind kind;
+        NodeType out;
+        NodeType in;   // 顶点操作中与 out 相同
+        std::optional<NodePropArg> node_prop;
+        std::optional<EdgePropArg> edge_prop;
+    };
+
+    // 写线程共享的增量
+    std::mutex delta_mutex;
+    std::vector<Op> delta;
+
+    // 发布者独占的可变图
+    std::mutex publish_mutex;
+    Base graph;
+
+    Snapshot current;
+
+    void enqueue(Op op){
+        std::lock_guard<std::mutex> lock(delta_mutex);
+        delta.emplace_back(std::move(op));
+    }
+
+    // 按提交顺序应用增量，连续的加边操作合并为一次批量插入
+    void apply(std::vector<Op>& ops, unsigned threads){
+        std::vector<std::pair<NodeType,NodeType>> edges;
+        std::vector<std::tuple<NodeType,NodeType,EdgePropArg>> prop_edges;
+        auto flush = [&](){
+            if constexpr (std::is_void_v<EdgePropType>) {
+                if (!edges.empty()) graph.add_edges(edges, threads);
+            } else {
+                if (!prop_edges.empty()) graph.add_edges_with_prop(prop_edges, threads);
+            }
+            edges.clear();
+            prop_edges.clear();
+        };
+
+        for (auto& op : ops) {
+            if (op.kind != OpKind::ADD_EDGE && op.kind != OpKind::ADD_EDGE_WITH_PROP) flush();
+            switch (op.kind) {
+                case OpKind::ADD_NODE:
+                    if constexpr (std::is_void_v<NodePropType>) graph.add_node(op.out);
+                    break;
+                case OpKind::ADD_NODE_WITH_PROP:
+                    if constexpr (!std::is_void_v<NodePropType>) graph.add_node_with_prop(op.out, *op.node_prop);
+                    break;
+                case OpKind::ADD_EDGE:
+                    if constexpr (std::is_void_v<EdgePropType>) edges.emplace_back(std::move(op.out), std::move(op.in));
+                    break;
+                case OpKind::ADD_EDGE_WITH_PROP:
+                    if constexpr (!std::is_void_v<EdgePropType>) prop_edges.emplace_back(std::move(op.out), std::move(op.in), std::move(*op.edge_prop));
+                    break;
+                case OpKind::REMOVE_NODE:
+                    graph.remove_node(op.out);
+                    break;
+                case OpKind::REMOVE_EDGE:
+                    graph.remove_edge(op.out, op.in);
+                    break;
+                case OpKind::REMOVE_EDGE_WITH_PROP:
+                    if constexpr (!std::is_void_v<EdgePropType>) graph.remove_edge_with_prop(op.out, op.in, *op.edge_prop);
+                    break;
+            }
+        }
+        flush();
+    }
+
+public:
+    ConcurrentGraph() : current(std::make_shared<const Version>(Version{0, graph.freeze()})) {}
+
+    // 以已有的图为第 0 版
+    explicit ConcurrentGraph(Base initial) : graph(std::move(initial)),
+        current(std::make_shared<const Version>(Version{0, graph.freeze()})) {}
+
+    ConcurrentGraph(const ConcurrentGraph&) = delete;
+    ConcurrentGraph& operator=(const ConcurrentGraph&) = delete;
+
+    // 添加无属性结点
+    void add_node(const NodeType& node){
+        static_assert((std::is_same_v<NodePropType,void>),"此图必须添加顶点属性!");
+        enqueue(Op{OpKind::ADD_NODE, node, node, std::nullopt, std::nullopt});
+    }
+
+    template<typename... Args>
+    void add_node(const NodeType& node, const Args&... rest_nodes){
+        static_assert((std::is_convertible_v<Args, NodeType> && ...), "所有结点必须为NodeType类型!");
+        add_node(node);
+        (add_node(rest_nodes), ...);
+    }
+
+    // 添加有属性顶点
+    void add_node_with_prop(const NodeType& node, const NodePropArg& nodeprop){
+        static_assert(!(std::is_same_v<NodePropType,void>),"此图不能添加顶点属性!");
+        enqueue(Op{OpKind::ADD_NODE_WITH_PROP, node, node, nodeprop, std::nullopt});
+    }
+
+    // 添加无属性边
+    void add_edge(const NodeType& outnode, const NodeType& innode){
+        static_assert((std::is_same_v<EdgePropType,void>),"此图必须添加边属性!");
+        enqueue(Op{OpKind::ADD_EDGE, outnode, innode, std::nullopt, std::nullopt});
+    }
+
+    // 添加有属性边
+    void add_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropArg& edgeprop){
+        static_assert(!(std::is_same_v<EdgePropType,void>),"此图不能添加边属性!");
+        enqueue(Op{OpKind::ADD_EDGE_WITH_PROP, outnode, innode, std::nullopt, edgeprop});
+    }
+
+    // 一次加锁追加一批边
+    void add_edges(const std::vector<std::pair<NodeType,NodeType>>& edges){
+        static_assert((std::is_same_v<EdgePropType,void>),"此图必须添加边属性!");
+        std::lock_guard<std::mutex> lock(delta_mutex);
+        for (auto& [u, v] : edges) delta.emplace_back(Op{OpKind::ADD_EDGE, u, v, std::nullopt, std::nullopt});
+    }
+
+    void add_edges_with_prop(const std::vector<std::tuple<NodeType,NodeType,EdgePropArg>>& edges){
+        static_assert(!(std::is_same_v<EdgePropType,void>),"此图不能添加边属性!");
+        std::lock_guard<std::mutex> lock(delta_mutex);
+        for (auto& [u, v, p] : edges) delta.emplace_back(Op{OpKind::ADD_EDGE_WITH_PROP, u, v, std::nullopt, p});
+    }
+
+    // 删除结点
+    void remove_node(const NodeType& node){
+        enqueue(Op{OpKind::REMOVE_NODE, node, node, std::nullopt, std::nullopt});
+    }
+
+    // 删除边
+    void remove_edge(const NodeType& outnode, const NodeType& innode){
+        enqueue(Op{OpKind::REMOVE_EDGE, outnode, innode, std::nullopt, std::nullopt});
+    }
+
+    void remove_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropArg& edgeprop){
+        static_assert(!(std::is_same_v<EdgePropType,void>),"此图没有边属性!");
+        enqueue(Op{OpKind::REMOVE_EDGE_WITH_PROP, outnode, innode, std::nullopt, edgeprop});
+    }
+
+    // 尚未发布的操作数
+    std::size_t pending() {
+        std::lock_guard<std::mutex> lock(delta_mutex);
+        return delta.size();
+    }
+
+    // 应用增量并发布新版本，返回新版本的 epoch；没有待发布的操作时直接返回当前 epoch
+    std::uint64_t publish(unsigned threads = 1){
+        std::lock_guard<std::mutex> lock(publish_mutex);
+        std::vector<Op> ops;
+        {
+            std::lock_guard<std::mutex> delta_lock(delta_mutex);
+            ops.swap(delta);
+        }
+        Snapshot previous = std::atomic_load(&current);
+        std::uint64_t epoch = previous->epoch;
+        if (ops.empty()) return epoch;
+
+        // 增量涉及的行与被删除过的顶点
+        std::vector<NodeType> dirty, removed;
+        dirty.reserve(ops.size());
+        for (auto& op : ops) {
+            if (op.kind == OpKind::REMOVE_NODE) {
+                removed.emplace_back(op.out);
+                continue;
+            }
+            dirty.emplace_back(op.out);
+            if constexpr (edge_direction == EdgeDirection::UNDIRECTED) {
+                if (op.in != op.out) dirty.emplace_back(op.in);
+            }
+        }
+
+        apply(ops, threads);
+        auto next = std::make_shared<const Version>(Version{epoch + 1, graph.freeze(previous->graph, dirty, removed)});
+        std::atomic_store(&current, Snapshot(std::move(next)));
+        return epoch + 1;
+    }
+
+    // 当前版本的快照，返回后可在任意线程中无锁遍历
+    Snapshot snapshot() const {
+        return std::atomic_load(&current);
+    }
+
+    std::uint64_t epoch() const {
+        return std::atomic_load(&current)->epoch;
+    }
+};
+
+#endif
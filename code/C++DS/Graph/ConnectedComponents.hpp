@@ -0,0 +1,130 @@
+#ifndef CONNECTEDCOMPONENTS_HPP
+#define CONNECTEDCOMPONENTS_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+#include <random>
+
+/**
+ * @file ConnectedComponents.hpp
+ * @brief Afforest 风格的并行连通分量，运行在 CSRGraph / MappedGraph 上。
+ *
+ * 1. 采样连接：每个顶点只取前 neighbor_rounds 个出边邻居进行合并，
+ *    对大多数真实图，这一步就能把绝大部分顶点并进同一个巨型分量。
+ * 2. 找巨型分量：压缩出每个顶点的代表元，随机抽样 samples 个顶点，出现最多的代表元视为巨型分量。
+ * 3. 补全：多个线程并行扫描不在巨型分量中的顶点的剩余边，两端代表元不同时合并，
+ *    巨型分量内部的边整段跳过。
+ *
+ * 有向图求的是弱连通分量：补全阶段同时扫描入边，因此从巨型分量指出的边也不会遗漏。
+ * 合并用无锁的并查集：parent 为原子数组，总是把较大的根用 CAS 挂到较小的根下，
+ * 多个线程可同时合并；压缩阶段并行做路径减半。每个分量的根就是其中最小的 id。
+ *
+ * 返回的 component[v] 是 [0, count) 内的紧凑分量编号，按分量中最小 id 的顺序编号。
+ */
+
+template<typename IdType>
+struct ComponentsResult {
+    std::vector<IdType> component;
+    IdType count;
+};
+
+template<typename CSR>
+ComponentsResult<typename CSR::id_type> connected_components(const CSR& g, unsigned threads = hardware_threads(),
+    std::size_t neighbor_rounds = 2, std::size_t samples = 1024){
+    using id_type = typename CSR::id_type;
+    const id_type n = g.num_nodes();
+    if (threads == 0) threads = 1;
+
+    std::vector<std::atomic<id_type>> parent(n);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t v = begin; v < end; ++v) parent[v].store(static_cast<id_type>(v), std::memory_order_relaxed);
+    }, 4096);
+
+    // 合并 u、v 所在的树：较大的根挂到较小的根下，CAS 失败说明根已变化，沿新的 parent 重试
+    auto link = [&parent](id_type u, id_type v){
+        id_type p1 = parent[u].load(std::memory_order_relaxed);
+        id_type p2 = parent[v].load(std::memory_order_relaxed);
+        while (p1 != p2) {
+            id_type high = std::max(p1, p2), low = std::min(p1, p2);
+            id_type p_high = parent[high].load(std::memory_order_relaxed);
+            if (p_high == low) break;
+            if (p_high == high && parent[high].compare_exchange_strong(p_high, low, std::memory_order_relaxed)) break;
+            p1 = parent[parent[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+            p2 = parent[low].load(std::memory_order_relaxed);
+        }
+    };
+
+    // 路径减半直到每个顶点直接指向根
+    auto compress = [&](){
+        parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+            for (std::size_t v = begin; v < end; ++v) {
+                id_type p = parent[v].load(std::memory_order_relaxed);
+                id_type pp = parent[p].load(std::memory_order_relaxed);
+                while (p != pp) {
+                    parent[v].store(pp, std::memory_order_relaxed);
+                    p = pp;
+                    pp = parent[p].load(std::memory_order_relaxed);
+                }
+            }
+        }, 4096);
+    };
+
+    // 1. 采样连接：第 r 轮取每个顶点的第 r 个出边邻居
+    for (std::size_t r = 0; r < neighbor_rounds; ++r) {
+        parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+            for (std::size_t vi = begin; vi < end; ++vi) {
+                id_type v = static_cast<id_type>(vi);
+                auto neighbors = g.out_neighbors(v);
+                if (r >= neighbors.size()) continue;
+                id_type u = *std::next(neighbors.begin(), r);
+                if (u != v) link(v, u);
+            }
+        }, 4096);
+        compress();
+    }
+
+    // 2. 抽样找出巨型分量的代表元
+    id_type giant = CSR::npos;
+    if (n > 0 && neighbor_rounds > 0) {
+        std::mt19937 rng(static_cast<std::uint32_t>(n));
+        std::uniform_int_distribution<id_type> pick(0, n - 1);
+        std::unordered_map<id_type, std::size_t> freq;
+        std::size_t best = 0;
+        for (std::size_t i = 0; i < samples; ++i) {
+            id_type root = parent[pick(rng)].load(std::memory_order_relaxed);
+            std::size_t f = ++freq[root];
+            if (f > best) {
+                best = f;
+                giant = root;
+            }
+        }
+    }
+
+    // 3. 补全：跳过巨型分量中的顶点，其余顶点的剩余边直接合并
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t vi = begin; vi < end; ++vi) {
+            id_type v = static_cast<id_type>(vi);
+            if (parent[v].load(std::memory_order_relaxed) == giant) continue;
+            auto neighbors = g.out_neighbors(v);
+            auto it = std::next(neighbors.begin(), std::min(neighbor_rounds, neighbors.size()));
+            for (; it != neighbors.end(); ++it) link(v, *it);
+            if constexpr (CSR::direction == EdgeDirection::DIRECTED) {
+                for (id_type u : g.in_neighbors(v)) link(v, u);
+            }
+        }
+    }, 4096);
+    compress();
+
+    // 紧凑编号
+    ComponentsResult<id_type> result{std::vector<id_type>(n), 0};
+    std::vector<id_type> remap(n, CSR::npos);
+    for (id_type v = 0; v < n; ++v) {
+        if (parent[v].load(std::memory_order_relaxed) == v) remap[v] = result.count++;
+    }
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t v = begin; v < end; ++v) result.component[v] = remap[parent[v].load(std::memory_order_relaxed)];
+    }, 4096);
+    return result;
+}
+
+#endif
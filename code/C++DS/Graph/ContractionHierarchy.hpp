@@ -0,0 +1,437 @@
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include "Graph.hpp"
+#include "ShortestPath.hpp"
+#include "PointToPoint.hpp"
+#include <fstream>
+#include <string>
+#include <cstring>
+
+/**
+ * @file ContractionHierarchy.hpp
+ * @brief 静态带权图的收缩层次(Contraction Hierarchies)：预处理、序列化与双向向上查询。
+ *
+ * 1. 预处理 ContractionHierarchy::build(g, weight, options):
+ *    - 按重要度从低到高逐个收缩顶点。收缩 v 时，对每对 u -> v -> x，若去掉 v 后从 u 到 x
+ *      找不到不长于 w(u,v) + w(v,x) 的见证路径(witness search，限定出堆顶点数的局部 Dijkstra)，就加一条捷径 u -> x；
+ *    - 重要度 = 边差分(需要加的捷径数 - 被删掉的边数) + 已收缩邻居数，后一项让收缩在图上分布均匀；
+ *    - 懒更新：弹出重要度最小的顶点后重新计算，若已不再是最小就放回堆中。
+ *
+ * 2. 层次结构：up[v] 保存 v 指向更高层顶点的弧，down[v] 保存从更高层顶点指向 v 的弧；
+ *    捷径记录被跳过的中间顶点，查询得到的路径可以递归展开成原图上的路径。
+ *
+ * 3. 查询 distance(s, t) / query(s, t)：从 s 沿 up、从 t 沿 down 各做一次只往高层走的 Dijkstra，
+ *    任一侧堆顶不小于当前最优值时该侧停止。搜索空间通常只有几百个顶点，与图的规模几乎无关。
+ *    distance 只做搜索；query 另外把层次路径上的捷径逐段展开(行内二分查找弧)。
+ *    查询复用 PointToPoint.hpp 的 SearchWorkspace(默认为 thread_local)，可在多个线程中并发调用。
+ *
+ * 4. save(path) / load(path) 把层次结构写成二进制文件，预处理一次，服务进程直接加载；
+ *    load 会在 O(n+m) 内检查文件内容(rank 为排列、偏移单调、顶点 id 在范围内等)，损坏的文件抛异常而不是越界访问。
+ *
+ * 顶点使用源图的稠密 id(与 CSRGraph::id_of 一致)；边权不能为负。
+ */
+
+struct ContractionOptions {
+    std::size_t witness_settle_limit = 500; // 见证搜索最多出堆的顶点数，越大捷径越少、预处理越慢
+};
+
+template<typename IdType, typename W>
+class ContractionHierarchy {
+public:
+    using id_type = IdType;
+    using offset_type = std::uint64_t;
+    static constexpr id_type npos = std::numeric_limits<id_type>::max();
+    static constexpr W inf = std::numeric_limits<W>::max();
+
+private:
+    std::vector<id_type> rank;            // 收缩次序，越大越重要
+
+    std::vector<offset_type> up_offsets{0};
+    std::vector<id_type> up_targets;
+    std::vector<W> up_weights;
+    std::vector<id_type> up_middle;       // 捷径的中间顶点，原始边为 npos
+
+    std::vector<offset_type> down_offsets{0};
+    std::vector<id_type> down_sources;
+    std::vector<W> down_weights;
+    std::vector<id_type> down_middle;
+
+    // 预处理期间的动态图
+    struct Arc {
+        id_type to;
+        W weight;
+        id_type middle;
+    };
+
+    // 查找层次中 a -> b 的弧，返回 (权, 中间顶点)；行内按邻居 id 有序，二分查找
+    std::pair<W, id_type> arc_between(id_type a, id_type b) const {
+        if (rank[b] > rank[a]) {
+            auto first = up_targets.begin() + up_offsets[a], last = up_targets.begin() + up_offsets[a+1];
+            auto it = std::lower_bound(first, last, b);
+            if (it != last && *it == b) {
+                auto e = it - up_targets.begin();
+                return {up_weights[e], up_middle[e]};
+            }
+        } else {
+            auto first = down_sources.begin() + down_offsets[b], last = down_sources.begin() + down_offsets[b+1];
+            auto it = std::lower_bound(first, last, a);
+            if (it != last && *it == a) {
+                auto e = it - down_sources.begin();
+                return {down_weights[e], down_middle[e]};
+            }
+        }
+        throw std::logic_error("ContractionHierarchy: 层次结构中不存在该弧!");
+    }
+
+    // 把层次路径上的弧 a -> b 展开成原图路径(不含 a)
+    void unpack(id_type a, id_type b, std::vector<id_type>& path) const {
+        std::vector<std::pair<id_type, id_type>> stack{{a, b}};
+        while (!stack.empty()) {
+            auto [x, y] = stack.back();
+            stack.pop_back();
+            id_type m = arc_between(x, y).second;
+            if (m == npos) {
+                path.emplace_back(y);
+            } else {
+                stack.emplace_back(m, y);
+                stack.emplace_back(x, m);
+            }
+        }
+    }
+
+    template<typename T>
+    static void write_array(std::ofstream& out, const std::vector<T>& v){
+        std::uint64_t size = v.size();
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        out.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(size * sizeof(T)));
+    }
+
+    template<typename T>
+    static void read_array(std::ifstream& in, std::vector<T>& v){
+        std::uint64_t size = 0;
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!in) throw std::runtime_error("ContractionHierarchy::load(): 文件被截断!");
+        v.resize(size);
+        in.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(size * sizeof(T)));
+        if (!in) throw std::runtime_error("ContractionHierarchy::load(): 文件被截断!");
+    }
+
+    // 双向向上搜索，返回 (最短距离, 相遇顶点)，不可达时相遇顶点为 npos；
+    // 结束后 ws 两侧保留父指针，供 query() 展开路径
+    std::pair<W, id_type> search(id_type s, id_type t, SearchWorkspace<id_type, W>& ws, std::size_t& settled) const {
+        const id_type n = num_nodes();
+        ws.prepare(n);
+        auto& fw = ws.forward();
+        auto& bw = ws.backward();
+
+        ws.reach(fw, s, 0, s);
+        ws.reach(bw, t, 0, t);
+        fw.heap.push(s, 0);
+        bw.heap.push(t, 0);
+        W best = inf;
+        id_type meet = npos;
+
+        auto step = [&](auto& self, auto& other, const std::vector<offset_type>& offsets,
+            const std::vector<id_type>& ends, const std::vector<W>& weights){
+            id_type u = static_cast<id_type>(self.heap.getTopIndex());
+            W du = self.heap.getTopKey();
+            self.heap.pop();
+            ws.settle(self, u);
+            ++settled;
+            W other_d = ws.distance(other, u);
+            if (other_d != inf && du + other_d < best) {
+                best = du + other_d;
+                meet = u;
+            }
+            for (offset_type e = offsets[u]; e < offsets[u+1]; ++e) {
+                id_type v = ends[e];
+                W nd = du + weights[e];
+                if (nd < ws.distance(self, v)) {
+                    ws.reach(self, v, nd, u);
+                    self.heap.pushOrDecrease(v, nd);
+                }
+            }
+        };
+
+        while (true) {
+            bool forward_live = !fw.heap.isEmpty() && fw.heap.getTopKey() < best;
+            bool backward_live = !bw.heap.isEmpty() && bw.heap.getTopKey() < best;
+            if (!forward_live && !backward_live) break;
+            if (forward_live && (!backward_live || fw.heap.getTopKey() <= bw.heap.getTopKey())) step(fw, bw, up_offsets, up_targets, up_weights);
+            else step(bw, fw, down_offsets, down_sources, down_weights);
+        }
+        return {best, meet};
+    }
+
+    void check_endpoints(id_type s, id_type t) const {
+        if (s >= num_nodes() || t >= num_nodes()) throw std::out_of_range("ContractionHierarchy::query(): 源点或终点不存在!");
+    }
+
+    // 检查载入的层次结构: 各数组长度一致，rank 是 0..n-1 的排列，偏移单调，
+    // 端点与中间顶点都在范围内，行内邻居严格升序(arc_between 二分依赖它)且 up 弧指向更高层、down 弧来自更高层
+    void validate() const {
+        auto fail = []{throw std::runtime_error("ContractionHierarchy::load(): 文件内容不一致!");};
+        const std::size_t n = rank.size();
+        if (n >= npos || up_offsets.size() != n + 1 || down_offsets.size() != n + 1
+            || up_offsets.front() != 0 || down_offsets.front() != 0
+            || up_offsets.back() != up_targets.size() || down_offsets.back() != down_sources.size()
+            || up_weights.size() != up_targets.size() || up_middle.size() != up_targets.size()
+            || down_weights.size() != down_sources.size() || down_middle.size() != down_sources.size())
+            fail();
+        std::vector<char> seen(n, 0);
+        for (id_type r : rank) {
+            if (r >= n || seen[r]) fail();
+            seen[r] = 1;
+        }
+        auto check_rows = [&](const std::vector<offset_type>& offsets, const std::vector<id_type>& ends,
+            const std::vector<W>& weights, const std::vector<id_type>& middle){
+            for (std::size_t v = 0; v < n; ++v) {
+                if (offsets[v] > offsets[v+1]) fail();
+                for (offset_type e = offsets[v]; e < offsets[v+1]; ++e) {
+                    if (ends[e] >= n || rank[ends[e]] <= rank[v] || (e > offsets[v] && ends[e-1] >= ends[e])) fail();
+                    if (middle[e] != npos && middle[e] >= n) fail();
+                    if (weights[e] < W(0)) fail();
+                }
+            }
+        };
+        check_rows(up_offsets, up_targets, up_weights, up_middle);
+        check_rows(down_offsets, down_sources, down_weights, down_middle);
+    }
+
+    static constexpr char file_magic[8] = {'D','S','A','C','H','I','E','R'};
+    static constexpr std::uint32_t file_version = 1;
+
+public:
+    ContractionHierarchy()=default;
+
+    id_type num_nodes() const noexcept {return static_cast<id_type>(rank.size());}
+    offset_type num_up_arcs() const noexcept {return up_targets.size();}
+    offset_type num_down_arcs() const noexcept {return down_sources.size();}
+    id_type rank_of(id_type v) const {return rank[v];}
+
+    template<typename CSR, typename WeightFn = IdentityWeight>
+    static ContractionHierarchy build(const CSR& g, WeightFn weight = {}, const ContractionOptions& options = {}){
+        static_assert(std::is_same_v<edge_weight_t<CSR, WeightFn>, W>, "边权类型不匹配!");
+        static_assert(std::is_arithmetic_v<W>, "边权必须是数值类型!");
+        const id_type n = g.num_nodes();
+        ContractionHierarchy ch;
+        ch.rank.assign(n, npos);
+
+        // 1. 动态图：平行边只保留最轻的一条，丢弃自环
+        std::vector<std::vector<Arc>> out(n), in(n);
+        std::vector<char> contracted(n, 0);
+        auto add_or_improve = [&](id_type u, id_type x, W w, id_type middle){
+            for (auto& a : out[u]) {
+                if (a.to != x) continue;
+                if (!(w < a.weight)) return;
+                a.weight = w;
+                a.middle = middle;
+                for (auto& b : in[x]) {
+                    if (b.to == u) {
+                        b.weight = w;
+                        b.middle = middle;
+                    }
+                }
+                return;
+            }
+            out[u].push_back({x, w, middle});
+            in[x].push_back({u, w, middle});
+        };
+        for (id_type u = 0; u < n; ++u) {
+            auto prop = g.out_edge_props(u).begin();
+            for (id_type v : g.out_neighbors(u)) {
+                W w = weight(*prop++);
+                if (w < W(0)) throw std::invalid_argument("ContractionHierarchy::build(): 存在负权边!");
+                if (u != v) add_or_improve(u, v, w, npos);
+            }
+        }
+
+        // 2. 见证搜索：从 u 出发、不经过 v，距离上限 limit
+        SearchWorkspace<id_type, W> ws;
+        auto witness = [&](id_type u, id_type v, W limit){
+            ws.prepare(n);
+            auto& side = ws.forward();
+            ws.reach(side, u, 0, u);
+            side.heap.push(u, 0);
+            std::size_t settled = 0;
+            while (!side.heap.isEmpty()) {
+                id_type x = static_cast<id_type>(side.heap.getTopIndex());
+                W dx = side.heap.getTopKey();
+                if (dx > limit || ++settled > options.witness_settle_limit) break;
+                side.heap.pop();
+                ws.settle(side, x);
+                for (auto& a : out[x]) {
+                    if (a.to == v || contracted[a.to] || ws.is_settled(side, a.to)) continue;
+                    W nd = dx + a.weight;
+                    if (nd < ws.distance(side, a.to)) {
+                        ws.reach(side, a.to, nd, x);
+                        side.heap.pushOrDecrease(a.to, nd);
+                    }
+                }
+            }
+            return &side;
+        };
+
+        // 收缩 v 需要的捷径；apply 为 true 时真正加入
+        auto shortcuts = [&](id_type v, bool apply){
+            std::int64_t count = 0;
+            W max_out = 0;
+            for (auto& a : out[v]) if (a.weight > max_out) max_out = a.weight;
+            std::vector<std::tuple<id_type, id_type, W>> added;
+            for (auto& ua : in[v]) {
+                id_type u = ua.to;
+                auto* side = witness(u, v, ua.weight + max_out);
+                for (auto& xa : out[v]) {
+                    id_type x = xa.to;
+                    if (x == u) continue;
+                    W need = ua.weight + xa.weight;
+                    if (ws.distance(*side, x) > need) {
+                        ++count;
+                        if (apply) added.emplace_back(u, x, need);
+                    }
+                }
+            }
+            for (auto& [u, x, w] : added) add_or_improve(u, x, w, v);
+            return count;
+        };
+
+        std::vector<std::int64_t> deleted_neighbors(n, 0);
+        auto priority = [&](id_type v){
+            std::int64_t removed = static_cast<std::int64_t>(in[v].size() + out[v].size());
+            return shortcuts(v, false) - removed + deleted_neighbors[v];
+        };
+
+        // 3. 懒更新的收缩顺序
+        IndexedPriorityQueue<std::int64_t> order(n);
+        for (id_type v = 0; v < n; ++v) order.push(v, priority(v));
+        id_type next_rank = 0;
+        while (!order.isEmpty()) {
+            id_type v = static_cast<id_type>(order.getTopIndex());
+            order.pop();
+            std::int64_t p = priority(v);
+            if (!order.isEmpty() && p > order.getTopKey()) {
+                order.push(v, p);
+                continue;
+            }
+
+            shortcuts(v, true);
+            contracted[v] = 1;
+            ch.rank[v] = next_rank++;
+
+            // v 剩余的弧都连向尚未收缩(更重要)的顶点，写入层次结构后从邻居的表中删除
+            for (auto& a : out[v]) {
+                in[a.to].erase(std::remove_if(in[a.to].begin(), in[a.to].end(), [v](const Arc& b){return b.to == v;}), in[a.to].end());
+                ++deleted_neighbors[a.to];
+            }
+            for (auto& a : in[v]) {
+                out[a.to].erase(std::remove_if(out[a.to].begin(), out[a.to].end(), [v](const Arc& b){return b.to == v;}), out[a.to].end());
+                ++deleted_neighbors[a.to];
+            }
+        }
+
+        // 4. 以 CSR 形式保存 up / down，行内按邻居 id 排序
+        // 收缩时 out[v]/in[v] 还保留着，此时正好都指向更高层的顶点
+        for (id_type v = 0; v < n; ++v) {
+            std::sort(out[v].begin(), out[v].end(), [](const Arc& a, const Arc& b){return a.to < b.to;});
+            for (auto& a : out[v]) {
+                ch.up_targets.emplace_back(a.to);
+                ch.up_weights.emplace_back(a.weight);
+                ch.up_middle.emplace_back(a.middle);
+            }
+            ch.up_offsets.emplace_back(ch.up_targets.size());
+            std::sort(in[v].begin(), in[v].end(), [](const Arc& a, const Arc& b){return a.to < b.to;});
+            for (auto& a : in[v]) {
+                ch.down_sources.emplace_back(a.to);
+                ch.down_weights.emplace_back(a.weight);
+                ch.down_middle.emplace_back(a.middle);
+            }
+            ch.down_offsets.emplace_back(ch.down_sources.size());
+        }
+        return ch;
+    }
+
+    // s 到 t 的最短路；path 为原图上的完整路径
+    PathResult<id_type, W> query(id_type s, id_type t, SearchWorkspace<id_type, W>* workspace = nullptr) const {
+        check_endpoints(s, t);
+        SearchWorkspace<id_type, W>& ws = workspace ? *workspace : thread_workspace<id_type, W>();
+        PathResult<id_type, W> result{inf, {}, 0};
+        auto [best, meet] = search(s, t, ws, result.settled);
+        if (meet == npos) return result;
+        result.distance = best;
+        auto& fw = ws.forward();
+        auto& bw = ws.backward();
+        // 向上路径 s -> meet，再接向下路径 meet -> t，逐段展开捷径
+        std::vector<id_type> hops;
+        for (id_type v = meet; v != s; v = fw.parent[v]) hops.emplace_back(v);
+        hops.emplace_back(s);
+        std::reverse(hops.begin(), hops.end());
+        for (id_type v = meet; v != t; ) {
+            v = bw.parent[v];
+            hops.emplace_back(v);
+        }
+        result.path.emplace_back(s);
+        for (std::size_t i = 0; i + 1 < hops.size(); ++i) unpack(hops[i], hops[i+1], result.path);
+        return result;
+    }
+
+    // 只求距离，不可达返回 inf；不展开路径
+    W distance(id_type s, id_type t, SearchWorkspace<id_type, W>* workspace = nullptr) const {
+        check_endpoints(s, t);
+        SearchWorkspace<id_type, W>& ws = workspace ? *workspace : thread_workspace<id_type, W>();
+        std::size_t settled = 0;
+        return search(s, t, ws, settled).first;
+    }
+
+    void save(const std::string& path) const {
+        static_assert(std::is_trivially_copyable_v<W>, "边权类型必须平凡可拷贝!");
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("ContractionHierarchy::save(): 无法打开文件 " + path);
+        out.write(file_magic, sizeof(file_magic));
+        std::uint32_t meta[3] = {file_version, static_cast<std::uint32_t>(sizeof(id_type)), static_cast<std::uint32_t>(sizeof(W))};
+        out.write(reinterpret_cast<const char*>(meta), sizeof(meta));
+        write_array(out, rank);
+        write_array(out, up_offsets);
+        write_array(out, up_targets);
+        write_array(out, up_weights);
+        write_array(out, up_middle);
+        write_array(out, down_offsets);
+        write_array(out, down_sources);
+        write_array(out, down_weights);
+        write_array(out, down_middle);
+        if (!out) throw std::runtime_error("ContractionHierarchy::save(): 写入失败 " + path);
+    }
+
+    static ContractionHierarchy load(const std::string& path){
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("ContractionHierarchy::load(): 无法打开文件 " + path);
+        char magic[8];
+        std::uint32_t meta[3];
+        in.read(magic, sizeof(magic));
+        in.read(reinterpret_cast<char*>(meta), sizeof(meta));
+        if (!in || std::memcmp(magic, file_magic, sizeof(magic)) != 0) throw std::runtime_error("ContractionHierarchy::load(): 不是收缩层次文件 " + path);
+        if (meta[0] != file_version) throw std::runtime_error("ContractionHierarchy::load(): 不支持的文件版本!");
+        if (meta[1] != sizeof(id_type) || meta[2] != sizeof(W)) throw std::runtime_error("ContractionHierarchy::load(): 文件的模板配置与当前类型不一致!");
+        ContractionHierarchy ch;
+        read_array(in, ch.rank);
+        read_array(in, ch.up_offsets);
+        read_array(in, ch.up_targets);
+        read_array(in, ch.up_weights);
+        read_array(in, ch.up_middle);
+        read_array(in, ch.down_offsets);
+        read_array(in, ch.down_sources);
+        read_array(in, ch.down_weights);
+        read_array(in, ch.down_middle);
+        ch.validate();
+        return ch;
+    }
+};
+
+// 由 CSR 推导模板参数
+template<typename CSR, typename WeightFn = IdentityWeight>
+ContractionHierarchy<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>
+build_contraction_hierarchy(const CSR& g, WeightFn weight = {}, const ContractionOptions& options = {}){
+    return ContractionHierarchy<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>::build(g, weight, options);
+}
+
+#endif
@@ -13,6 +13,12 @@
 #include <type_traits>
 #include <iterator>
 #include <optional>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+#include "GraphParallel.hpp"
 
 
 // 枚举对象类型
@@ -32,6 +38,9 @@ enum class EdgeDirection {DIRECTED, UNDIRECTED};
 // 邻接表外层的数据类型
 enum class Map {MAP, UNORDERED_MAP};
 
+// 有向图是否额外维护入边索引(删除顶点时只需访问真实邻居)
+enum class InEdgeIndex {NONE, MAINTAINED};
+
 
 
 
@@ -126,7 +135,7 @@ struct EdgePropStorageSelector {
     using type = std::unordered_map<Pair, EdgePropType, Hash>;
 };
 
-template<typename NodeType, typename EdgePropType, MultiEdge multi>
+template<typename NodeType, typename EdgePropType>
 struct EdgePropStorageSelector<NodeType, EdgePropType, MultiEdge::ALLOWED> {
 	using Pair = std::pair<NodeType, NodeType>;
 	using Hash = PairHash<NodeType, NodeType>;
@@ -138,6 +147,11 @@ struct EdgePropStorageSelector<NodeType, void, multi> {
     using type = empty_edge_prop;
 };
 
+template<typename NodeType>
+struct EdgePropStorageSelector<NodeType, void, MultiEdge::ALLOWED> {
+    using type = empty_edge_prop;
+};
+
 
 // 顶点查找返回值
 template <typename NodeType, typename NodePropType>
@@ -148,7 +162,7 @@ struct NodeInfo {
 
 // 边查找返回值
 template <typename NodeType, typename EdgePropType>
-struct NodeInfo {
+struct EdgeInfo {
     const NodeType& from;
 	const NodeType& to;
     const EdgePropType* prop;
@@ -171,6 +185,272 @@ template<typename T>
 constexpr bool is_less_comparable_v = is_less_comparable<T>::value;
 
 
+// 只读 CSR(压缩稀疏行) 快照
+
+// 连续内存区间视图，CSR 的邻居、边属性都以它的形式返回，不发生拷贝
+template<typename T>
+class CSRRange {
+private:
+	const T* first;
+	const T* last;
+public:
+	CSRRange(const T* first=nullptr, const T* last=nullptr) : first(first), last(last) {}
+
+	const T* begin() const noexcept {return first;}
+	const T* end() const noexcept {return last;}
+	const T* data() const noexcept {return first;}
+	std::size_t size() const noexcept {return static_cast<std::size_t>(last-first);}
+	bool empty() const noexcept {return first==last;}
+	const T& operator[](std::size_t i) const {return first[i];}
+};
+
+// 可变图邻居容器的只读视图，直接遍历 Graph 内部的邻居容器，不发生拷贝
+// 视图及其迭代器的失效规则与底层容器相同：修改该顶点的邻居(或删除该顶点)后不可再使用
+template<typename Container>
+class NeighborRange {
+private:
+	const Container* neigh;
+public:
+	using iterator = typename Container::const_iterator;
+	using value_type = typename Container::value_type;
+
+	explicit NeighborRange(const Container& neigh) : neigh(&neigh) {}
+
+	iterator begin() const {return neigh->begin();}
+	iterator end() const {return neigh->end();}
+	std::size_t size() const noexcept {return neigh->size();}
+	bool empty() const noexcept {return neigh->empty();}
+};
+
+template<typename NodeType, typename NodePropType, typename EdgePropType,
+    EdgeDirection edge_direction, MultiEdge multi_edge, SelfLoop self_loop,
+    Map adj_list_spec, Container neighbors_container_spec, InEdgeIndex in_edge_index>
+class Graph;
+
+/**
+ * CSRGraph 由 Graph::freeze() 生成，顶点被映射为 [0, n) 的稠密 id(按邻接表遍历顺序)
+ * out_offsets[u]..out_offsets[u+1] 是 u 的出边在 out_targets/out_props 中的区间，边属性与邻居平行存放
+ * 每行邻居按 id 升序排列；重复边在行内相邻出现，无向图的每条边在两端各出现一次(自环只出现一次)
+ * 有向图额外保存一份转置(入边)，无向图的入边视图即出边视图
+ */
+template<typename NodeType=int, typename NodePropType=void, typename EdgePropType=void,
+    EdgeDirection edge_direction=EdgeDirection::UNDIRECTED,
+    Map node_index_spec=Map::UNORDERED_MAP>
+class CSRGraph{
+public:
+	using id_type = std::uint32_t;
+	using offset_type = std::uint64_t;
+	static constexpr id_type npos = std::numeric_limits<id_type>::max();
+	static constexpr EdgeDirection direction = edge_direction;
+	using node_type = NodeType;
+	using node_prop_type = NodePropType;
+	using edge_prop_type = EdgePropType;
+
+	using NodePropColumn = std::conditional_t<std::is_void_v<NodePropType>, empty_node_prop, std::vector<NodePropType>>;
+	using EdgePropColumn = std::conditional_t<std::is_void_v<EdgePropType>, empty_edge_prop, std::vector<EdgePropType>>;
+
+private:
+	template<typename, typename, typename, EdgeDirection, MultiEdge, SelfLoop, Map, Container, InEdgeIndex>
+	friend class Graph;
+	template<typename, typename, typename, EdgeDirection, Map>
+	friend class CSRGraph;
+
+	using NodeIndex = typename AdjListSelector<node_index_spec, NodeType, id_type>::type;
+
+	std::vector<NodeType> id_to_node;
+	NodeIndex node_to_id;
+
+	std::vector<offset_type> out_offsets{0};
+	std::vector<id_type> out_targets;
+	EdgePropColumn out_props;
+
+	std::vector<offset_type> in_offsets{0}; // 仅有向图使用
+	std::vector<id_type> in_sources;
+	EdgePropColumn in_props;
+
+	NodePropColumn node_props;
+	offset_type self_loops = 0;
+
+	static constexpr bool has_node_prop = !std::is_void_v<NodePropType>;
+	static constexpr bool has_edge_prop = !std::is_void_v<EdgePropType>;
+
+	// 行内按邻居 id 排序(边属性随之移动)，有向图再构造转置
+	void finalize(){
+		const id_type n = static_cast<id_type>(id_to_node.size());
+		std::vector<offset_type> order(out_targets.size());
+		for (offset_type i=0;i<order.size();++i) order[i]=i;
+		bool sorted = true;
+		for (id_type u=0;u<n;++u) {
+			auto first = order.begin()+out_offsets[u], last = order.begin()+out_offsets[u+1];
+			if (!std::is_sorted(out_targets.begin()+out_offsets[u], out_targets.begin()+out_offsets[u+1])) {
+				sorted = false;
+				std::stable_sort(first, last, [this](offset_type a, offset_type b){return out_targets[a]<out_targets[b];});
+			}
+		}
+		if (!sorted) {
+			std::vector<id_type> targets(out_targets.size());
+			for (offset_type i=0;i<order.size();++i) targets[i]=out_targets[order[i]];
+			out_targets.swap(targets);
+			if constexpr (has_edge_prop) {
+				std::vector<EdgePropType> props;
+				props.reserve(out_props.size());
+				for (offset_type i=0;i<order.size();++i) props.emplace_back(std::move(out_props[order[i]]));
+				out_props.swap(props);
+			}
+		}
+
+		self_loops = 0;
+		for (id_type u=0;u<n;++u) {
+			for (offset_type e=out_offsets[u];e<out_offsets[u+1];++e) {
+				if (out_targets[e]==u) self_loops++;
+			}
+		}
+
+		if constexpr (direction == EdgeDirection::DIRECTED) { // 计数 -> 前缀和 -> 回填，源点按升序写入，入边行天然有序
+			in_offsets.assign(n+1,0);
+			for (id_type v : out_targets) in_offsets[v+1]++;
+			for (id_type v=0;v<n;++v) in_offsets[v+1]+=in_offsets[v];
+			std::vector<offset_type> cursor(in_offsets.begin(), in_offsets.end()-1);
+			in_sources.resize(out_targets.size());
+			std::vector<offset_type> where(out_targets.size());
+			for (id_type u=0;u<n;++u) {
+				for (offset_type e=out_offsets[u];e<out_offsets[u+1];++e) {
+					offset_type pos = cursor[out_targets[e]]++;
+					in_sources[pos] = u;
+					where[pos] = e;
+				}
+			}
+			if constexpr (has_edge_prop) {
+				in_props.clear();
+				in_props.reserve(where.size());
+				for (offset_type e : where) in_props.emplace_back(out_props[e]);
+			}
+		}
+	}
+
+	void build_index(){
+		node_to_id.clear();
+		if constexpr (node_index_spec == Map::UNORDERED_MAP) node_to_id.reserve(id_to_node.size());
+		for (id_type i=0;i<id_to_node.size();++i) {
+			if (!node_to_id.try_emplace(id_to_node[i], i).second) throw std::invalid_argument("CSRGraph: 顶点重复!");
+		}
+	}
+
+public:
+	CSRGraph()=default;
+
+	// 直接由 CSR 数组构造，offsets 长度须为 nodes.size()+1，邻居用稠密 id 表示
+	CSRGraph(std::vector<NodeType> nodes, std::vector<offset_type> offsets, std::vector<id_type> targets,
+		EdgePropColumn edge_props = {}, NodePropColumn nodeprops = {})
+		: id_to_node(std::move(nodes)), out_offsets(std::move(offsets)), out_targets(std::move(targets)),
+		  out_props(std::move(edge_props)), node_props(std::move(nodeprops)) {
+		static_assert(id_type(-1) == npos, "id 类型不匹配!");
+		if (id_to_node.size() >= npos) throw std::length_error("CSRGraph: 顶点数超出 32 位 id 范围!");
+		if (out_offsets.size() != id_to_node.size()+1 || out_offsets.front() != 0 || out_offsets.back() != out_targets.size())
+			throw std::invalid_argument("CSRGraph: offsets 与 targets 不匹配!");
+		for (std::size_t i=0;i+1<out_offsets.size();++i) {
+			if (out_offsets[i] > out_offsets[i+1]) throw std::invalid_argument("CSRGraph: offsets 必须单调不减!");
+		}
+		for (id_type v : out_targets) {
+			if (v >= id_to_node.size()) throw std::out_of_range("CSRGraph: 邻居 id 越界!");
+		}
+		if constexpr (has_edge_prop) {
+			if (out_props.size() != out_targets.size()) throw std::invalid_argument("CSRGraph: 边属性数量与边数不匹配!");
+		}
+		if constexpr (has_node_prop) {
+			if (node_props.size() != id_to_node.size()) throw std::invalid_argument("CSRGraph: 顶点属性数量与顶点数不匹配!");
+		}
+		build_index();
+		finalize();
+	}
+
+	// 换一套顶点键接管另一个 CSRGraph 的全部数组，nodes[i] 为 id i 的新键
+	// 数组整体移动过来，行已有序、转置已建好，不再校验与排序，只重建 顶点 -> id 索引
+	template<typename OtherNodeType, Map other_index_spec>
+	CSRGraph(std::vector<NodeType> nodes, CSRGraph<OtherNodeType, NodePropType, EdgePropType, edge_direction, other_index_spec>&& other)
+		: id_to_node(std::move(nodes)), out_offsets(std::move(other.out_offsets)), out_targets(std::move(other.out_targets)),
+		  out_props(std::move(other.out_props)), in_offsets(std::move(other.in_offsets)), in_sources(std::move(other.in_sources)),
+		  in_props(std::move(other.in_props)), node_props(std::move(other.node_props)), self_loops(other.self_loops) {
+		if (id_to_node.size() != other.id_to_node.size()) throw std::invalid_argument("CSRGraph: 顶点键数量与原图不匹配!");
+		build_index();
+	}
+
+	// 规模
+	id_type num_nodes() const noexcept {return static_cast<id_type>(id_to_node.size());}
+	offset_type num_arcs() const noexcept {return out_targets.size();} // 邻接项总数(无向边计两次)
+	offset_type num_edges() const noexcept {
+		if constexpr (direction == EdgeDirection::UNDIRECTED) return (out_targets.size()+self_loops)/2;
+		else return out_targets.size();
+	}
+	offset_type num_self_loops() const noexcept {return self_loops;}
+
+	// 顶点与 id 互查
+	id_type id_of(const NodeType& node) const {
+		auto it = node_to_id.find(node);
+		return it==node_to_id.end() ? npos : it->second;
+	}
+	bool has_node(const NodeType& node) const {return node_to_id.find(node)!=node_to_id.end();}
+	const NodeType& node_of(id_type id) const {return id_to_node[id];}
+
+	// 度
+	offset_type out_degree(id_type u) const {return out_offsets[u+1]-out_offsets[u];}
+	offset_type in_degree(id_type u) const {
+		if constexpr (direction == EdgeDirection::DIRECTED) return in_offsets[u+1]-in_offsets[u];
+		else return out_degree(u);
+	}
+	offset_type degree(id_type u) const {
+		if constexpr (direction == EdgeDirection::DIRECTED) return out_degree(u)+in_degree(u);
+		else return out_degree(u);
+	}
+
+	// 邻居
+	CSRRange<id_type> out_neighbors(id_type u) const {
+		return {out_targets.data()+out_offsets[u], out_targets.data()+out_offsets[u+1]};
+	}
+	CSRRange<id_type> in_neighbors(id_type u) const {
+		if constexpr (direction == EdgeDirection::DIRECTED) return {in_sources.data()+in_offsets[u], in_sources.data()+in_offsets[u+1]};
+		else return out_neighbors(u);
+	}
+
+	// 属性
+	template<typename P = EdgePropType>
+	CSRRange<P> out_edge_props(id_type u) const {
+		static_assert(has_edge_prop,"此图不存在边属性!");
+		return {out_props.data()+out_offsets[u], out_props.data()+out_offsets[u+1]};
+	}
+	template<typename P = EdgePropType>
+	CSRRange<P> in_edge_props(id_type u) const {
+		static_assert(has_edge_prop,"此图不存在边属性!");
+		if constexpr (direction == EdgeDirection::DIRECTED) return {in_props.data()+in_offsets[u], in_props.data()+in_offsets[u+1]};
+		else return out_edge_props(u);
+	}
+	template<typename P = NodePropType>
+	const P& node_prop(id_type u) const {
+		static_assert(has_node_prop,"此图不存在顶点属性!");
+		return node_props[u];
+	}
+
+	// 查边：返回 u->v 第一条边在 out_targets 中的下标，不存在返回 npos_edge
+	static constexpr offset_type npos_edge = std::numeric_limits<offset_type>::max();
+	offset_type edge_index(id_type u, id_type v) const {
+		auto first = out_targets.begin()+out_offsets[u], last = out_targets.begin()+out_offsets[u+1];
+		auto it = std::lower_bound(first, last, v);
+		return (it!=last && *it==v) ? static_cast<offset_type>(it-out_targets.begin()) : npos_edge;
+	}
+	bool has_edge(id_type u, id_type v) const {return edge_index(u,v)!=npos_edge;}
+
+	// 原始数组，供遍历内核直接线性扫描
+	const std::vector<NodeType>& nodes() const noexcept {return id_to_node;}
+	const std::vector<offset_type>& offsets() const noexcept {return out_offsets;}
+	const std::vector<id_type>& targets() const noexcept {return out_targets;}
+	const std::vector<offset_type>& reverse_offsets() const noexcept {return direction==EdgeDirection::DIRECTED ? in_offsets : out_offsets;}
+	const std::vector<id_type>& reverse_sources() const noexcept {return direction==EdgeDirection::DIRECTED ? in_sources : out_targets;}
+	const EdgePropColumn& edge_prop_column() const noexcept {return out_props;}
+	const EdgePropColumn& reverse_edge_prop_column() const noexcept {return direction==EdgeDirection::DIRECTED ? in_props : out_props;}
+	const NodePropColumn& node_prop_column() const noexcept {return node_props;}
+};
+
+
 // 类定义
 
 template<typename NodeType=int, typename NodePropType=void, typename EdgePropType=void,
@@ -178,7 +458,8 @@ template<typename NodeType=int, typename NodePropType=void, typename EdgePropTyp
     MultiEdge multi_edge=MultiEdge::DISALLOWED,
     SelfLoop self_loop=SelfLoop::DISALLOWED,
     Map adj_list_spec=Map::UNORDERED_MAP,
-    Container neighbors_container_spec=Container::UNORDERED_SET>
+    Container neighbors_container_spec=Container::UNORDERED_SET,
+    InEdgeIndex in_edge_index=InEdgeIndex::NONE>
 
 class Graph{
 private:
@@ -195,11 +476,180 @@ private:
 	NodeProps node_props;
 	EdgeProps edge_props;
 
+	// 属性为void时作为形参的占位类型
+	using NodePropArg = std::conditional_t<std::is_void_v<NodePropType>, empty_node_prop, NodePropType>;
+	using EdgePropArg = std::conditional_t<std::is_void_v<EdgePropType>, empty_edge_prop, EdgePropType>;
+
 private:
 	//类内参数常量
 	static constexpr EdgeDirection direction = edge_direction;
     static constexpr MultiEdge multi = multi_edge;
     static constexpr SelfLoop selfloop = self_loop;
+	static constexpr bool track_in_edges = (edge_direction == EdgeDirection::DIRECTED && in_edge_index == InEdgeIndex::MAINTAINED);
+
+	// 入边索引：in_adj[v] 保存所有指向 v 的顶点(重复边重复保存)，无向图邻接表本身对称，不需要
+	struct empty_in_index {};
+	using InAdjList = std::conditional_t<track_in_edges, AdjList, empty_in_index>;
+
+	InAdjList in_adj;
+
+	// 删除容器中所有等于 node 的元素，返回删除个数
+	static std::size_t erase_all(NeighborContainer& neigh, const NodeType& node){
+		if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) {
+			auto erase_start = std::remove(neigh.begin(), neigh.end(), node);
+			std::size_t removed = std::distance(erase_start, neigh.end());
+			neigh.erase(erase_start, neigh.end());
+			return removed;
+		} else {
+			return neigh.erase(node);
+		}
+	}
+
+	// 记录 outnode -> innode
+	void link_in(const NodeType& outnode, const NodeType& innode){
+		if constexpr (track_in_edges) {
+			auto& preds = in_adj.find(innode)->second;
+			if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) {
+				preds.emplace_back(outnode);
+			} else {
+				preds.emplace(outnode);
+			}
+		}
+	}
+
+	// 撤销 count 条 outnode -> innode
+	void unlink_in(const NodeType& outnode, const NodeType& innode, std::size_t count){
+		if constexpr (track_in_edges) {
+			auto& preds = in_adj.find(innode)->second;
+			for (std::size_t i=0;i<count;++i) {
+				auto where = preds.end();
+				if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) {
+					where = std::find(preds.begin(), preds.end(), outnode);
+				} else {
+					where = preds.find(outnode);
+				}
+				if (where == preds.end()) break;
+				preds.erase(where);
+			}
+		}
+	}
+
+	// 批量插入的实现，元素通过 std::get<0/1/2> 访问，pair 与 tuple 均可
+	template<bool with_prop, typename It>
+	int bulk_insert(It first, It last, unsigned threads){
+		struct Arc {
+			NeighborContainer* out_neigh;
+			NeighborContainer* in_neigh;
+			const NodeType* out;
+			const NodeType* in;
+			std::size_t idx;
+		};
+		std::vector<Arc> arcs;
+		if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>) {
+			arcs.reserve(static_cast<std::size_t>(std::distance(first, last)));
+		}
+
+		// 1. 解析端点，过滤不存在的顶点和不允许的自环；无向边统一成 (小, 大) 方向
+		std::size_t idx = 0;
+		for (It it = first; it != last; ++it, ++idx) {
+			auto it_out = adj_list.find(std::get<0>(*it)), it_in = adj_list.find(std::get<1>(*it));
+			if (it_out == adj_list.end() || it_in == adj_list.end()) continue;
+			if constexpr (selfloop == SelfLoop::DISALLOWED) {
+				if (it_out == it_in) continue;
+			}
+			if constexpr (direction == EdgeDirection::UNDIRECTED) {
+				if (it_in->first < it_out->first) std::swap(it_out, it_in);
+			}
+			arcs.push_back({&it_out->second, &it_in->second, &it_out->first, &it_in->first, idx});
+		}
+
+		// 2. 按源点分组，组内按终点排序
+		std::sort(arcs.begin(), arcs.end(), [](const Arc& a, const Arc& b){
+			if (a.out_neigh != b.out_neigh) return std::less<const void*>{}(a.out_neigh, b.out_neigh);
+			if (*a.in < *b.in) return true;
+			if (*b.in < *a.in) return false;
+			return a.idx < b.idx;
+		});
+
+		// 3. 不允许重复边时，组内去重并剔除已存在的边(顺序容器先排序一份已有邻居再二分)
+		if constexpr (multi == MultiEdge::DISALLOWED) {
+			std::vector<Arc> kept;
+			kept.reserve(arcs.size());
+			std::vector<NodeType> existing;
+			for (std::size_t g = 0; g < arcs.size();) {
+				std::size_t h = g;
+				while (h < arcs.size() && arcs[h].out_neigh == arcs[g].out_neigh) ++h;
+				auto& neigh = *arcs[g].out_neigh;
+				if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) {
+					existing.assign(neigh.begin(), neigh.end());
+					std::sort(existing.begin(), existing.end());
+				}
+				for (std::size_t i = g; i < h; ++i) {
+					if (i > g && !(*arcs[i-1].in < *arcs[i].in)) continue; // 批内重复
+					bool present;
+					if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) {
+						present = std::binary_search(existing.begin(), existing.end(), *arcs[i].in);
+					} else {
+						present = neigh.find(*arcs[i].in) != neigh.end();
+					}
+					if (!present) kept.emplace_back(arcs[i]);
+				}
+				g = h;
+			}
+			arcs.swap(kept);
+		}
+
+		// 4. 写入邻居容器：每个容器的插入集中成一组，组间互不相交，可并行
+		std::vector<std::pair<NeighborContainer*, const NodeType*>> inserts;
+		inserts.reserve(arcs.size() * (direction == EdgeDirection::UNDIRECTED ? 2 : 1));
+		for (auto& a : arcs) {
+			inserts.emplace_back(a.out_neigh, a.in);
+			if constexpr (direction == EdgeDirection::UNDIRECTED) {
+				if (a.out_neigh != a.in_neigh) inserts.emplace_back(a.in_neigh, a.out);
+			}
+		}
+		if constexpr (track_in_edges) {
+			for (auto& a : arcs) inserts.emplace_back(&in_adj.find(*a.in)->second, a.out);
+		}
+		std::stable_sort(inserts.begin(), inserts.end(), [](const auto& a, const auto& b){
+			return std::less<const void*>{}(a.first, b.first);
+		});
+		std::vector<std::size_t> groups;
+		for (std::size_t i = 0; i < inserts.size(); ++i) {
+			if (i == 0 || inserts[i].first != inserts[i-1].first) groups.emplace_back(i);
+		}
+		groups.emplace_back(inserts.size());
+
+		parallel_for(groups.size()-1, threads, [&](std::size_t begin, std::size_t end, unsigned){
+			for (std::size_t g = begin; g < end; ++g) {
+				auto& neigh = *inserts[groups[g]].first;
+				if constexpr (neighbors_container_spec == Container::VEC) {
+					neigh.reserve(neigh.size() + (groups[g+1] - groups[g]));
+				}
+				for (std::size_t i = groups[g]; i < groups[g+1]; ++i) {
+					if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) {
+						neigh.emplace_back(*inserts[i].second);
+					} else {
+						neigh.emplace(*inserts[i].second);
+					}
+				}
+			}
+		}, 64);
+
+		// 5. 边属性表是单个哈希表，按输入顺序串行写入
+		if constexpr (with_prop) {
+			std::sort(arcs.begin(), arcs.end(), [](const Arc& a, const Arc& b){return a.idx < b.idx;});
+			edge_props.reserve(edge_props.size() + arcs.size());
+			It it = first;
+			std::size_t pos = 0;
+			for (auto& a : arcs) {
+				std::advance(it, a.idx - pos);
+				pos = a.idx;
+				edge_props.emplace(std::make_pair(*a.out, *a.in), std::get<2>(*it));
+			}
+		}
+		return static_cast<int>(arcs.size());
+	}
 
 public:
 	Graph(){
@@ -211,6 +661,9 @@ public:
 	int add_node(const NodeType& node){
 		static_assert((std::is_same_v<NodePropType,void>),"此图必须添加顶点属性!");
 		bool inserted = adj_list.try_emplace(node).second;
+		if constexpr (track_in_edges) {
+			if (inserted) in_adj.try_emplace(node);
+		}
 		return inserted;
 	}
 	
@@ -228,9 +681,12 @@ public:
 
 
 	// 添加有属性顶点
-	int add_node_with_prop(const NodeType& node,const NodePropType& nodeprop){
+	int add_node_with_prop(const NodeType& node,const NodePropArg& nodeprop){
 		static_assert(!(std::is_same_v<NodePropType,void>),"此图不能添加顶点属性!");
 		bool inserted = adj_list.try_emplace(node).second;
+		if constexpr (track_in_edges) {
+			if (inserted) in_adj.try_emplace(node);
+		}
 		if (inserted) {
 			node_props.emplace(node,nodeprop);
 		}
@@ -278,10 +734,11 @@ public:
 		} else {
 			it_out->second.emplace(innode);
 			if constexpr (direction == EdgeDirection::UNDIRECTED) {
-				if (innode!=outnode) it_in->second.emplace_back(outnode);
+				if (innode!=outnode) it_in->second.emplace(outnode);
 			}
 		}
 		
+		link_in(outnode, innode);
 		return 1;
 	}
 
@@ -308,6 +765,7 @@ public:
 			}
 
 			count++;
+			link_in(outnode, innode);
 			if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) { // 邻居容器配置
 				it_out->second.emplace_back(innode);
 				if constexpr (direction == EdgeDirection::UNDIRECTED) { // 无向图：再插入 in -> out
@@ -346,6 +804,7 @@ public:
 			}
 
 			count++;
+			link_in(outnode, innode);
 			if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) { // 邻居容器配置
 				it_out->second.emplace_back(innode);
 				if constexpr (direction == EdgeDirection::UNDIRECTED) { // 无向图：再插入 in -> out
@@ -362,7 +821,7 @@ public:
 	}
 
 	// 添加带属性边
-	int add_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropType& edgeprop){
+	int add_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropArg& edgeprop){
 		static_assert(!(std::is_same_v<EdgePropType,void>),"此图不能添加边属性!");
 		auto it_out = adj_list.find(outnode),it_in  = adj_list.find(innode);
 
@@ -393,53 +852,87 @@ public:
 			}
 		}
 		if constexpr (direction == EdgeDirection::UNDIRECTED){
-			edge_props.emplace({std::min(outnode,innode),std::max(outnode,innode)},edgeprop); // 这里只记录了一个方向的边
+			edge_props.emplace(std::make_pair(std::min(outnode,innode),std::max(outnode,innode)),edgeprop); // 这里只记录了一个方向的边
 		}else{
-			edge_props.emplace({outnode,innode},edgeprop);
+			edge_props.emplace(std::make_pair(outnode,innode),edgeprop);
 		} 
+		link_in(outnode, innode);
 		return 1;
 	}
 
+	// 批量添加边：按源点分组后一次去重、一次预留容量，不同源点的邻居容器可由多个线程并行写入
+	// 语义与逐条调用 add_edge 相同(返回值为实际插入的边数，重复边保留批内第一次出现的那条)
+	template<typename It>
+	int add_edges(It first, It last, unsigned threads = 1){
+		static_assert((std::is_same_v<EdgePropType,void>),"此图必须添加边属性!");
+		return bulk_insert<false>(first, last, threads);
+	}
+
+	int add_edges(const std::vector<std::pair<NodeType,NodeType>>& edges, unsigned threads = 1){
+		return add_edges(edges.begin(), edges.end(), threads);
+	}
+
+	// 批量添加带属性边，元素为 (outnode, innode, edgeprop)
+	template<typename It>
+	int add_edges_with_prop(It first, It last, unsigned threads = 1){
+		static_assert(!(std::is_same_v<EdgePropType,void>),"此图不能添加边属性!");
+		return bulk_insert<true>(first, last, threads);
+	}
+
+	int add_edges_with_prop(const std::vector<std::tuple<NodeType,NodeType,EdgePropArg>>& edges, unsigned threads = 1){
+		return add_edges_with_prop(edges.begin(), edges.end(), threads);
+	}
+
     // 删除结点
 	int remove_node(const NodeType& node) {
 		auto it = adj_list.find(node);
 		if (it == adj_list.end()) {
 			return 0;
 		}
-		if constexpr (!std::is_same_v<EdgePropType, void>) {
+		auto& neigh_node = it->second;
+
+		if constexpr (direction == EdgeDirection::UNDIRECTED) { // 无向图邻接表对称，只需访问它自己的邻居
+			for (auto& v : neigh_node) {
+				if (v == node) continue;
+				erase_all(adj_list.find(v)->second, node);
+			}
+			if constexpr (!std::is_same_v<EdgePropType, void>) {
+				for (auto& v : neigh_node) {
+					edge_props.erase(std::make_pair(std::min(v,node), std::max(v,node)));
+				}
+			}
+		} else if constexpr (track_in_edges) { // 有向图 + 入边索引：出边邻居和入边邻居各访问一次
+			auto it_in = in_adj.find(node);
+			for (auto& v : neigh_node) {
+				if (v != node) erase_all(in_adj.find(v)->second, node);
+			}
+			for (auto& u : it_in->second) {
+				if (u != node) erase_all(adj_list.find(u)->second, node);
+			}
+			if constexpr (!std::is_same_v<EdgePropType, void>) {
+				for (auto& v : neigh_node) edge_props.erase(std::make_pair(node,v));
+				for (auto& u : it_in->second) edge_props.erase(std::make_pair(u,node));
+			}
+			in_adj.erase(it_in);
+		} else if constexpr (!std::is_same_v<EdgePropType, void>) { // 有向图无索引：扫描整个邻接表
 			std::unordered_set<NodeType> regarding_nodes;
 			// 删除其它节点对它的引用
 			for (auto& [u, neigh] : adj_list) {
 				if (u == node) continue;
-				if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) {
-					auto erase_start = std::remove(neigh.begin(), neigh.end(), node);
-					if(erase_start != neigh.end()) regarding_nodes.emplace(u);
-					neigh.erase(erase_start, neigh.end());
-				} else {
-					if (neigh.erase(node)>0) regarding_nodes.emplace(u);
-				}
+				if (erase_all(neigh, node) > 0) regarding_nodes.emplace(u);
 			}
 
-			// 删除相关边
-			if constexpr (direction == EdgeDirection::UNDIRECTED){
-				for(auto& regarding_node : regarding_nodes){
-					edge_props.erase(std::make_pair(std::min(regarding_node,node), std::max(regarding_node,node)));
-				}
-			}else{
-				for(auto& regarding_node : regarding_nodes){ //有向图正反都要删除
-					edge_props.erase(std::make_pair(regarding_node,node));
-					edge_props.erase(std::make_pair(node,regarding_node));
-				}
+			// 删除相关边，有向图正反都要删除
+			for(auto& regarding_node : regarding_nodes){
+				edge_props.erase(std::make_pair(regarding_node,node));
 			}
-
-		}else{
+			for (auto& v : neigh_node) {
+				edge_props.erase(std::make_pair(node,v));
+			}
+		} else {
 			for (auto& [u, neigh] : adj_list) {
 				if (u == node) continue;
-				if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST) {
-					neigh.erase(std::remove(neigh.begin(), neigh.end(), node), neigh.end());
-				} else {
-					neigh.erase(node);
-				}
+				erase_all(neigh, node);
 			}
 		}
 
@@ -485,6 +978,7 @@ public:
 						edge_props.erase(std::make_pair(outnode, innode));
 					}
 				}
+				unlink_in(outnode, innode, 1);
 				return 1;
 			} else {
 				int removed = neigh_out.erase(innode); // 删 out -> innode 这一条
@@ -498,6 +992,7 @@ public:
 						edge_props.erase(std::make_pair(outnode, innode));
 					}
 				}
+				unlink_in(outnode, innode, removed);
 				return removed;
 			}
 		} else {  // 可重复边
@@ -519,6 +1014,7 @@ public:
 						edge_props.erase(std::make_pair(outnode, innode));
 					}
 				}
+				unlink_in(outnode, innode, removed);
 				return removed;
 			} else {
 				removed = neigh_out.erase(innode); // 删 out -> innode
@@ -532,12 +1028,13 @@ public:
 						edge_props.erase(std::make_pair(outnode, innode));
 					}
 				}
+				unlink_in(outnode, innode, removed);
 				return removed;
 			}
 		}
 	} 
 
-	int remove_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropType& edgeprop){
+	int remove_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropArg& edgeprop){
 		static_assert(!(std::is_same_v<EdgePropType,void>),"此图不存在边属性!");
 		auto it_out = adj_list.find(outnode);
 		auto it_in  = adj_list.find(innode);
@@ -550,7 +1047,7 @@ public:
 				if(where_in == neigh_out.end()) return 0;
 
 				// 从边属性表里删除边
-				EdgeProps::iterator edge_loc;
+				typename EdgeProps::iterator edge_loc;
 				if constexpr (direction == EdgeDirection::UNDIRECTED) {
 					edge_loc=edge_props.find(std::make_pair(std::min(outnode, innode),std::max(outnode, innode)));
 				} else {
@@ -565,9 +1062,10 @@ public:
 					neigh_in.erase(std::find(neigh_in.begin(),neigh_in.end(),outnode));
 				}
 
+				unlink_in(outnode, innode, 1);
 				return 1;
 			} else {
-				EdgeProps::iterator edge_loc;
+				typename EdgeProps::iterator edge_loc;
 				if constexpr (direction == EdgeDirection::UNDIRECTED) {
 					edge_loc=edge_props.find(std::make_pair(std::min(outnode, innode),std::max(outnode, innode)));
 				} else {
@@ -581,12 +1079,13 @@ public:
 					it_in->second.erase(outnode);
 				}
 
+				unlink_in(outnode, innode, 1);
 				return 1;
 			}
 		} else {  // 可重复边
 			size_t removed=0;
 
-			std::pair<EdgeProps::iterator,EdgeProps::iterator> check_edge;
+			std::pair<typename EdgeProps::iterator,typename EdgeProps::iterator> check_edge;
 			if constexpr (direction == EdgeDirection::UNDIRECTED) { // 删边表
 				check_edge = edge_props.equal_range(std::make_pair(std::min(outnode, innode),std::max(outnode, innode)));
 			} else {
@@ -651,6 +1150,7 @@ public:
 					}
 				}
 			}
+			unlink_in(outnode, innode, removed);
 			return removed;
 		}
 	}
@@ -660,22 +1160,26 @@ public:
 
     std::optional<NodeInfo<NodeType,NodePropType>> find_node(const NodeType& node) const {
 		if constexpr(std::is_same_v<NodePropType,void>){
-			auto& findnode = adj_list.find(node);
-			return (findnode==adj_list.end())? std::nullopt : NodeInfo<NodeType,NodePropType>{node,nullptr};
+			auto findnode = adj_list.find(node);
+			if (findnode==adj_list.end()) return std::nullopt;
+			return NodeInfo<NodeType,NodePropType>{findnode->first,nullptr};
 		} else {
-			auto& findnode = node_props.find(node);
-			return (findnode==adj_list.end())? std::nullopt : NodeInfo<NodeType,NodePropType>{node,&(findnode->second)};
+			auto findnode = node_props.find(node);
+			if (findnode==node_props.end()) return std::nullopt;
+			return NodeInfo<NodeType,NodePropType>{findnode->first,&(findnode->second)};
 		}
 	}
 
 	// 查找边
 	int has_edge(const NodeType& outnode,const NodeType& innode) const{
 		if constexpr(std::is_same_v<EdgePropType,void>) {
-			auto& neigh_out = adj_list.find(outnode);
+			auto it_out = adj_list.find(outnode);
+			if (it_out == adj_list.end()) return 0;
+			auto& neigh_out = it_out->second;
 			if constexpr (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST){
 				return std::count(neigh_out.begin(),neigh_out.end(),innode);
 			} else {
-				return neigh_out->count(innode);
+				return neigh_out.count(innode);
 			}
 		} else {
 			if constexpr (direction == EdgeDirection::UNDIRECTED){
@@ -686,6 +1190,342 @@ public:
 		}
 	}
 
+private:
+	static constexpr bool sequence_neighbors = (neighbors_container_spec == Container::VEC || neighbors_container_spec == Container::LIST);
+
+	static const NeighborContainer& no_neighbors(){
+		static const NeighborContainer empty;
+		return empty;
+	}
+
+	// u -> v 的第 k 条边的属性(重复边：第 k 次出现的 v 对应 equal_range 中第 k 个属性，与 freeze() 一致)
+	// k 由 occurrence() 按需给出：u -> v 只有一条边时不调用，没有重复边的邻居每步只需一次哈希查找
+	template<typename P = EdgePropType, typename Occurrence>
+	const P& edge_prop_at(const NodeType& u, const NodeType& v, const Occurrence& occurrence) const {
+		auto key = (direction == EdgeDirection::UNDIRECTED) ? std::make_pair(std::min(u,v),std::max(u,v)) : std::make_pair(u,v);
+		if constexpr (multi == MultiEdge::DISALLOWED) {
+			return edge_props.find(key)->second;
+		} else {
+			auto [found, last] = edge_props.equal_range(key);
+			if (std::next(found) != last) std::advance(found, occurrence());
+			return found->second;
+		}
+	}
+
+public:
+	// 带边属性的邻居视图，元素为 std::pair<const NodeType&, const EdgePropType&>：
+	//    for (auto [v, prop] : g.out_edges(u)) ...
+	// 属性按需从边属性表中查出，不拷贝邻居也不拷贝属性；in_edges() 的 first 是入边的起点
+	// 代价：每步一次哈希查找；只有 VEC/LIST 存放的真正平行边需要回扫本行前缀确定是第几条，为 O(度数)
+	class EdgeRange {
+	private:
+		const Graph* graph;
+		const NodeType* node;
+		const NeighborContainer* neigh;
+		bool reversed; // true 时 node 是边的终点
+
+	public:
+		class iterator {
+		private:
+			EdgeRange range; // 视图只有几个指针，按值保存，迭代器不依赖视图对象的生命周期
+			typename NeighborContainer::const_iterator cur;
+			std::size_t run = 0; // 关联容器中相同元素相邻，run 为当前元素此前连续出现的次数
+
+			std::size_t occurrence() const {
+				if constexpr (multi == MultiEdge::DISALLOWED) return 0;
+				else if constexpr (sequence_neighbors) return static_cast<std::size_t>(std::count(range.neigh->begin(), cur, *cur));
+				else return run;
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::pair<const NodeType&, const EdgePropType&>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type;
+
+			iterator(const EdgeRange& range, typename NeighborContainer::const_iterator cur) : range(range), cur(cur) {}
+
+			reference operator*() const {
+				const NodeType& other = *cur;
+				auto k = [this]{return occurrence();};
+				if (range.reversed) return {other, range.graph->edge_prop_at(other, *range.node, k)};
+				return {other, range.graph->edge_prop_at(*range.node, other, k)};
+			}
+			// 当前邻居，不查边属性
+			const NodeType& target() const {return *cur;}
+			iterator& operator++(){
+				auto prev = cur++;
+				if constexpr (multi == MultiEdge::ALLOWED && !sequence_neighbors) {
+					run = (cur != range.neigh->end() && *cur == *prev) ? run+1 : 0;
+				}
+				return *this;
+			}
+			iterator operator++(int){
+				iterator old = *this;
+				++*this;
+				return old;
+			}
+			bool operator==(const iterator& other) const {return cur == other.cur;}
+			bool operator!=(const iterator& other) const {return cur != other.cur;}
+		};
+
+		EdgeRange(const Graph* graph, const NodeType* node, const NeighborContainer& neigh, bool reversed)
+			: graph(graph), node(node), neigh(&neigh), reversed(reversed) {}
+
+		iterator begin() const {return {*this, neigh->begin()};}
+		iterator end() const {return {*this, neigh->end()};}
+		std::size_t size() const noexcept {return neigh->size();}
+		bool empty() const noexcept {return neigh->empty();}
+	};
+
+	// 邻居视图：不存在的顶点返回空视图；无向图中 in_neighbors 与 out_neighbors 相同
+	NeighborRange<NeighborContainer> out_neighbors(const NodeType& node) const {
+		auto it = adj_list.find(node);
+		return NeighborRange<NeighborContainer>(it == adj_list.end() ? no_neighbors() : it->second);
+	}
+	NeighborRange<NeighborContainer> neighbors(const NodeType& node) const {return out_neighbors(node);}
+
+	NeighborRange<NeighborContainer> in_neighbors(const NodeType& node) const {
+		static_assert(direction == EdgeDirection::UNDIRECTED || track_in_edges, "有向图需要 InEdgeIndex::MAINTAINED 才能遍历入邻居!");
+		if constexpr (track_in_edges) {
+			auto it = in_adj.find(node);
+			return NeighborRange<NeighborContainer>(it == in_adj.end() ? no_neighbors() : it->second);
+		} else {
+			return out_neighbors(node);
+		}
+	}
+
+	EdgeRange out_edges(const NodeType& node) const {
+		static_assert(!(std::is_same_v<EdgePropType,void>),"此图不存在边属性!");
+		auto it = adj_list.find(node);
+		if (it == adj_list.end()) return EdgeRange(this, nullptr, no_neighbors(), false);
+		return EdgeRange(this, &it->first, it->second, false);
+	}
+
+	EdgeRange in_edges(const NodeType& node) const {
+		static_assert(!(std::is_same_v<EdgePropType,void>),"此图不存在边属性!");
+		static_assert(direction == EdgeDirection::UNDIRECTED || track_in_edges, "有向图需要 InEdgeIndex::MAINTAINED 才能遍历入边!");
+		if constexpr (track_in_edges) {
+			auto it = in_adj.find(node);
+			if (it == in_adj.end()) return EdgeRange(this, nullptr, no_neighbors(), true);
+			return EdgeRange(this, &it->first, it->second, true);
+		} else {
+			return out_edges(node);
+		}
+	}
+
+	// 度：不存在的顶点为 0；无向图自环只计一次(与 CSRGraph 相同)
+	std::size_t out_degree(const NodeType& node) const {
+		auto it = adj_list.find(node);
+		return it == adj_list.end() ? 0 : it->second.size();
+	}
+
+	// 有向图未维护入边索引时需扫描全部邻接表，O(V+E)
+	std::size_t in_degree(const NodeType& node) const {
+		if constexpr (direction == EdgeDirection::UNDIRECTED) {
+			return out_degree(node);
+		} else if constexpr (track_in_edges) {
+			auto it = in_adj.find(node);
+			return it == in_adj.end() ? 0 : it->second.size();
+		} else {
+			if (adj_list.find(node) == adj_list.end()) return 0;
+			std::size_t count = 0;
+			for (auto& [u, neigh] : adj_list) {
+				if constexpr (sequence_neighbors) count += std::count(neigh.begin(), neigh.end(), node);
+				else count += neigh.count(node);
+			}
+			return count;
+		}
+	}
+
+	std::size_t degree(const NodeType& node) const {
+		if constexpr (direction == EdgeDirection::DIRECTED) return out_degree(node) + in_degree(node);
+		else return out_degree(node);
+	}
+
+private:
+	// 访问 u 的一行邻接项；无向图只在较小端点处访问，使每条边恰好出现一次
+	template<typename Row, typename F>
+	void visit_row(const Row& row, F& f) const {
+		const NodeType& u = row.first;
+		if constexpr (std::is_same_v<EdgePropType,void>) {
+			for (const NodeType& v : row.second) {
+				if constexpr (direction == EdgeDirection::UNDIRECTED) {
+					if (v < u) continue;
+				}
+				f(u, v);
+			}
+		} else {
+			EdgeRange range(this, &u, row.second, false);
+			for (auto it = range.begin(), last = range.end(); it != last; ++it) {
+				if constexpr (direction == EdgeDirection::UNDIRECTED) {
+					if (it.target() < u) continue;
+				}
+				auto [v, prop] = *it;
+				f(u, v, prop);
+			}
+		}
+	}
+
+public:
+	// 遍历每条边一次：无边属性时调用 f(u, v)，否则调用 f(u, v, prop)；重复边逐条访问
+	template<typename F>
+	void for_each_edge(F&& f) const {
+		for (auto& row : adj_list) visit_row(row, f);
+	}
+
+	// 并行版本：按顶点分块，f 会被多个线程同时调用，需自行保证线程安全；遍历期间不得修改本图
+	template<typename F>
+	void for_each_edge(F&& f, unsigned threads) const {
+		std::vector<const typename AdjList::value_type*> rows;
+		rows.reserve(adj_list.size());
+		for (auto& row : adj_list) rows.emplace_back(&row);
+		parallel_for(rows.size(), threads == 0 ? 1 : threads, [&](std::size_t begin, std::size_t end, unsigned){
+			for (std::size_t i = begin; i < end; ++i) visit_row(*rows[i], f);
+		}, 64);
+	}
+
+public:
+	// 冻结为只读 CSR 快照，适合读多写少的遍历场景；之后对本图的修改不会反映到快照中
+	using Frozen = CSRGraph<NodeType, NodePropType, EdgePropType, edge_direction, adj_list_spec>;
+
+private:
+	// 把 u 的邻居(及边属性)追加到 csr 的 out_targets / out_props 末尾；
+	// 重复边：第 k 次出现的 v 对应 equal_range 中第 k 个属性，seen 为调用方提供的计数缓冲
+	template<typename IdType>
+	void freeze_row(Frozen& csr, const NodeType& u, const NeighborContainer& neigh, std::unordered_map<IdType, std::size_t>& seen) const {
+		for (auto& v : neigh) {
+			csr.out_targets.emplace_back(csr.node_to_id.find(v)->second);
+			if constexpr (!std::is_void_v<EdgePropType>) {
+				auto key = (direction == EdgeDirection::UNDIRECTED) ? std::make_pair(std::min(u,v),std::max(u,v)) : std::make_pair(u,v);
+				if constexpr (multi == MultiEdge::DISALLOWED) {
+					auto found = edge_props.find(key);
+					if (found == edge_props.end()) throw std::logic_error("Graph::freeze(): 邻接表与边属性表不一致!");
+					csr.out_props.emplace_back(found->second);
+				} else {
+					auto range = edge_props.equal_range(key);
+					std::size_t k = seen[csr.out_targets.back()]++;
+					auto found = range.first;
+					for (std::size_t i=0;i<k && found!=range.second;++i) ++found;
+					if (found == range.second) throw std::logic_error("Graph::freeze(): 邻接表与边属性表不一致!");
+					csr.out_props.emplace_back(found->second);
+				}
+			}
+		}
+		if constexpr (!std::is_void_v<EdgePropType> && multi == MultiEdge::ALLOWED) seen.clear();
+	}
+
+public:
+	Frozen freeze() const {
+		using id_type = typename Frozen::id_type;
+		Frozen csr;
+		if (adj_list.size() >= Frozen::npos) throw std::length_error("Graph::freeze(): 顶点数超出 32 位 id 范围!");
+
+		csr.id_to_node.reserve(adj_list.size());
+		for (auto& [u, neigh] : adj_list) csr.id_to_node.emplace_back(u);
+		csr.build_index();
+
+		std::size_t arcs = 0;
+		for (auto& [u, neigh] : adj_list) arcs += neigh.size();
+		csr.out_offsets.clear();
+		csr.out_offsets.reserve(adj_list.size()+1);
+		csr.out_offsets.emplace_back(0);
+		csr.out_targets.reserve(arcs);
+		if constexpr (!std::is_void_v<EdgePropType>) csr.out_props.reserve(arcs);
+		if constexpr (!std::is_void_v<NodePropType>) csr.node_props.reserve(adj_list.size());
+
+		std::unordered_map<id_type, std::size_t> seen;
+		for (auto& [u, neigh] : adj_list) {
+			freeze_row(csr, u, neigh, seen);
+			if constexpr (!std::is_void_v<NodePropType>) csr.node_props.emplace_back(node_props.find(u)->second);
+			csr.out_offsets.emplace_back(csr.out_targets.size());
+		}
+		csr.finalize();
+		return csr;
+	}
+
+	// 增量冻结：previous 是本图早先 freeze() 得到的快照(或上一次增量冻结的结果)，此后只有 dirty 中顶点的出边行变化过，
+	// removed 中的顶点被删除过(之后可能又被加回)；新加入的顶点必须出现在 dirty 中，否则抛出 std::logic_error。
+	// 保留下来的顶点沿用原来的相对顺序，新顶点追加在末尾；未变化的行直接从 previous 拷贝并重映射 id，
+	// 只有 dirty 行和曾指向 removed 顶点的行从邻接表重建，重建部分的哈希查找与被触及的边数成正比。
+	Frozen freeze(const Frozen& previous, const std::vector<NodeType>& dirty, const std::vector<NodeType>& removed = {}) const {
+		using id_type = typename Frozen::id_type;
+		using offset_type = typename Frozen::offset_type;
+		if (adj_list.size() >= Frozen::npos) throw std::length_error("Graph::freeze(): 顶点数超出 32 位 id 范围!");
+		const id_type old_n = previous.num_nodes();
+
+		// 1. 标记需要重建的旧行，收集新顶点
+		std::vector<char> rebuild(old_n, 0);
+		for (auto& v : removed) {
+			id_type id = previous.id_of(v);
+			if (id == Frozen::npos) continue;
+			rebuild[id] = 1;
+			for (id_type w : previous.in_neighbors(id)) rebuild[w] = 1;
+		}
+		std::vector<NodeType> added;
+		for (auto& v : dirty) {
+			id_type id = previous.id_of(v);
+			if (id != Frozen::npos) rebuild[id] = 1;
+			else if (adj_list.find(v) != adj_list.end()) added.emplace_back(v);
+		}
+		std::sort(added.begin(), added.end());
+		added.erase(std::unique(added.begin(), added.end()), added.end());
+
+		// 2. 分配 id：保留的旧顶点在前，新顶点在后
+		Frozen csr;
+		std::vector<id_type> remap(old_n, Frozen::npos), origin;
+		csr.id_to_node.reserve(adj_list.size());
+		origin.reserve(old_n);
+		for (id_type i=0;i<old_n;++i) {
+			const NodeType& v = previous.id_to_node[i];
+			if (!removed.empty() && adj_list.find(v) == adj_list.end()) continue;
+			remap[i] = static_cast<id_type>(csr.id_to_node.size());
+			origin.emplace_back(i);
+			csr.id_to_node.emplace_back(v);
+		}
+		for (auto& v : added) csr.id_to_node.emplace_back(v);
+		if (csr.id_to_node.size() != adj_list.size()) throw std::logic_error("Graph::freeze(): 增量信息与图不一致!");
+		if (removed.empty()) {
+			csr.node_to_id = previous.node_to_id;
+			for (std::size_t i=origin.size();i<csr.id_to_node.size();++i) csr.node_to_id.emplace(csr.id_to_node[i], static_cast<id_type>(i));
+		} else {
+			csr.build_index();
+		}
+
+		// 3. 逐行拷贝或重建
+		const id_type n = static_cast<id_type>(csr.id_to_node.size());
+		csr.out_offsets.clear();
+		csr.out_offsets.reserve(n+1);
+		csr.out_offsets.emplace_back(0);
+		csr.out_targets.reserve(previous.num_arcs());
+		if constexpr (!std::is_void_v<EdgePropType>) csr.out_props.reserve(previous.num_arcs());
+		if constexpr (!std::is_void_v<NodePropType>) csr.node_props.reserve(n);
+		std::unordered_map<id_type, std::size_t> seen;
+		for (id_type i=0;i<n;++i) {
+			id_type old = i < origin.size() ? origin[i] : Frozen::npos;
+			if (old != Frozen::npos && !rebuild[old]) {
+				offset_type first = previous.out_offsets[old], last = previous.out_offsets[old+1];
+				for (offset_type e=first;e<last;++e) {
+					id_type v = remap[previous.out_targets[e]];
+					if (v == Frozen::npos) throw std::logic_error("Graph::freeze(): 增量信息与图不一致!");
+					csr.out_targets.emplace_back(v);
+				}
+				if constexpr (!std::is_void_v<EdgePropType>) {
+					csr.out_props.insert(csr.out_props.end(), previous.out_props.begin()+first, previous.out_props.begin()+last);
+				}
+				if constexpr (!std::is_void_v<NodePropType>) csr.node_props.emplace_back(previous.node_props[old]);
+			} else {
+				auto it = adj_list.find(csr.id_to_node[i]);
+				freeze_row(csr, it->first, it->second, seen);
+				if constexpr (!std::is_void_v<NodePropType>) csr.node_props.emplace_back(node_props.find(it->first)->second);
+			}
+			csr.out_offsets.emplace_back(csr.out_targets.size());
+		}
+		csr.finalize();
+		return csr;
+	}
+
 	int has_node(){
 		
 	}
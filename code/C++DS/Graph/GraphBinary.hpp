@@ -0,0 +1,431 @@
+#ifndef GRAPHBINARY_HPP
+#define GRAPHBINARY_HPP
+
+#include "Graph.hpp"
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <memory>
+
+#if defined(_WIN32)
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file GraphBinary.hpp
+ * @brief CSRGraph 的二进制文件格式，以及基于 mmap 的零拷贝只读图 MappedGraph。
+ *
+ * 文件布局(所有段按 64 字节对齐，整数为本机字节序):
+ *    GraphFileHeader                     魔数、版本、字节序标记、模板配置(有向与否、各类型的类型标签)、规模、各段偏移
+ *    nodes[n]                            id -> 顶点
+ *    sorted_ids[n]                       按顶点键升序排列的 id，用于二分查找 顶点 -> id
+ *    out_offsets[n+1], out_targets[m]    出边 CSR
+ *    out_props[m]                        出边属性(EdgePropType 非 void 时)
+ *    in_offsets[n+1], in_sources[m]      入边 CSR(仅有向图)
+ *    in_props[m]                         入边属性(仅有向图且 EdgePropType 非 void)
+ *    node_props[n]                       顶点属性(NodePropType 非 void 时)
+ *
+ * 顶点与属性类型必须是平凡可拷贝的(std::string 等需要先驻留为 id，见 InternedGraph.hpp)。
+ * 每个类型记录一个类型标签: 类别(bool/有符号整数/无符号整数/浮点/枚举/结构体)、sizeof，
+ * 以及用户类型号(特化 graph_file_type_id 给出，默认 0)。打开文件时标签与字节序标记都要一致，
+ * 因此 int 与 float、int32 与 uint32、不同字节序的机器之间不会被误读。
+ * 文件内容默认只做 O(1) 的一致性检查；构造 MappedGraph 时传入 verify_contents = true 会再做一遍 O(n+m) 的检查:
+ * 偏移单调、每个目标/源顶点 id < n、sorted_ids 严格按顶点键升序(从而是 0..n-1 的排列)。
+ * 来源不可信的文件应当打开这项检查，否则损坏的文件会导致越界访问。
+ * MappedGraph 与 CSRGraph 的只读接口一致，ParallelBFS 等算法可以直接作用在它上面。
+ * Windows 下没有 mmap，退化为把整个文件读入内存。
+ */
+
+// 用户类型号，结构体等类型可以特化它来区分同样大小的不同类型
+template<typename T>
+struct graph_file_type_id : std::integral_constant<std::uint64_t, 0> {};
+
+enum class GraphFileKind : std::uint32_t {NONE, BOOL, SIGNED, UNSIGNED, FLOATING, ENUMERATION, RECORD};
+
+// 一个类型的类型标签
+struct GraphFileType {
+    std::uint32_t kind;             // GraphFileKind
+    std::uint32_t size;             // sizeof，void 为 0
+    std::uint64_t type_id;          // graph_file_type_id<T>
+};
+
+struct GraphFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t directed;
+    std::uint32_t endian;           // graph_file_endian，按本机字节序写入
+    std::uint32_t reserved;
+    GraphFileType node_type;
+    GraphFileType node_prop_type;   // void 为 NONE
+    GraphFileType edge_prop_type;   // void 为 NONE
+    std::uint64_t num_nodes;
+    std::uint64_t num_arcs;
+    std::uint64_t self_loops;
+    // 各段相对文件头的字节偏移，0 表示该段不存在
+    std::uint64_t nodes;
+    std::uint64_t sorted_ids;
+    std::uint64_t out_offsets;
+    std::uint64_t out_targets;
+    std::uint64_t out_props;
+    std::uint64_t in_offsets;
+    std::uint64_t in_sources;
+    std::uint64_t in_props;
+    std::uint64_t node_props;
+    std::uint64_t file_size;
+};
+
+inline constexpr char graph_file_magic[8] = {'D','S','A','G','R','A','P','H'};
+inline constexpr std::uint32_t graph_file_version = 2;
+inline constexpr std::uint32_t graph_file_endian = 0x01020304;
+
+template<typename T>
+constexpr GraphFileType graph_file_type(){
+    if constexpr (std::is_void_v<T>) return {static_cast<std::uint32_t>(GraphFileKind::NONE), 0, 0};
+    else {
+        GraphFileKind kind = GraphFileKind::RECORD;
+        if constexpr (std::is_same_v<T, bool>) kind = GraphFileKind::BOOL;
+        else if constexpr (std::is_integral_v<T>) kind = std::is_signed_v<T> ? GraphFileKind::SIGNED : GraphFileKind::UNSIGNED;
+        else if constexpr (std::is_floating_point_v<T>) kind = GraphFileKind::FLOATING;
+        else if constexpr (std::is_enum_v<T>) kind = GraphFileKind::ENUMERATION;
+        return {static_cast<std::uint32_t>(kind), static_cast<std::uint32_t>(sizeof(T)), graph_file_type_id<T>::value};
+    }
+}
+
+inline bool operator==(const GraphFileType& a, const GraphFileType& b){
+    return a.kind == b.kind && a.size == b.size && a.type_id == b.type_id;
+}
+inline bool operator!=(const GraphFileType& a, const GraphFileType& b){return !(a == b);}
+
+template<typename T>
+constexpr bool graph_file_storable_v = std::is_void_v<T> || std::is_trivially_copyable_v<T>;
+
+// 把 CSRGraph 写成二进制文件
+template<typename NodeType, typename NodePropType, typename EdgePropType, EdgeDirection edge_direction, Map node_index_spec>
+void write_graph_binary(const CSRGraph<NodeType, NodePropType, EdgePropType, edge_direction, node_index_spec>& g, const std::string& path){
+    static_assert(graph_file_storable_v<NodeType>, "顶点类型必须平凡可拷贝!");
+    static_assert(graph_file_storable_v<NodePropType>, "顶点属性类型必须平凡可拷贝!");
+    static_assert(graph_file_storable_v<EdgePropType>, "边属性类型必须平凡可拷贝!");
+    using CSR = CSRGraph<NodeType, NodePropType, EdgePropType, edge_direction, node_index_spec>;
+    using id_type = typename CSR::id_type;
+    using offset_type = typename CSR::offset_type;
+    constexpr bool directed = edge_direction == EdgeDirection::DIRECTED;
+
+    const std::uint64_t n = g.num_nodes(), m = g.num_arcs();
+
+    std::vector<id_type> sorted_ids(n);
+    for (id_type i = 0; i < n; ++i) sorted_ids[i] = i;
+    std::sort(sorted_ids.begin(), sorted_ids.end(), [&](id_type a, id_type b){return g.node_of(a) < g.node_of(b);});
+
+    GraphFileHeader header{};
+    std::memcpy(header.magic, graph_file_magic, sizeof(header.magic));
+    header.version = graph_file_version;
+    header.directed = directed;
+    header.endian = graph_file_endian;
+    header.node_type = graph_file_type<NodeType>();
+    header.node_prop_type = graph_file_type<NodePropType>();
+    header.edge_prop_type = graph_file_type<EdgePropType>();
+    header.num_nodes = n;
+    header.num_arcs = m;
+    header.self_loops = g.num_self_loops();
+
+    // 先排好各段偏移
+    std::uint64_t cursor = sizeof(GraphFileHeader);
+    auto place = [&cursor](std::uint64_t bytes){
+        cursor = (cursor + 63) / 64 * 64;
+        std::uint64_t at = cursor;
+        cursor += bytes;
+        return at;
+    };
+    header.nodes = place(n * sizeof(NodeType));
+    header.sorted_ids = place(n * sizeof(id_type));
+    header.out_offsets = place((n + 1) * sizeof(offset_type));
+    header.out_targets = place(m * sizeof(id_type));
+    if constexpr (!std::is_void_v<EdgePropType>) header.out_props = place(m * sizeof(EdgePropType));
+    if constexpr (directed) {
+        header.in_offsets = place((n + 1) * sizeof(offset_type));
+        header.in_sources = place(m * sizeof(id_type));
+        if constexpr (!std::is_void_v<EdgePropType>) header.in_props = place(m * sizeof(EdgePropType));
+    }
+    if constexpr (!std::is_void_v<NodePropType>) header.node_props = place(n * sizeof(NodePropType));
+    header.file_size = cursor;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("write_graph_binary(): 无法打开文件 " + path);
+
+    std::uint64_t written = 0;
+    auto put = [&](std::uint64_t at, const void* data, std::uint64_t bytes){
+        static const char zeros[64] = {};
+        while (written < at) { // 对齐填充
+            std::uint64_t pad = std::min<std::uint64_t>(at - written, sizeof(zeros));
+            out.write(zeros, static_cast<std::streamsize>(pad));
+            written += pad;
+        }
+        if (bytes) out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        written += bytes;
+    };
+    put(0, &header, sizeof(header));
+    put(header.nodes, g.nodes().data(), n * sizeof(NodeType));
+    put(header.sorted_ids, sorted_ids.data(), n * sizeof(id_type));
+    put(header.out_offsets, g.offsets().data(), (n + 1) * sizeof(offset_type));
+    put(header.out_targets, g.targets().data(), m * sizeof(id_type));
+    if constexpr (!std::is_void_v<EdgePropType>) put(header.out_props, g.edge_prop_column().data(), m * sizeof(EdgePropType));
+    if constexpr (directed) {
+        put(header.in_offsets, g.reverse_offsets().data(), (n + 1) * sizeof(offset_type));
+        put(header.in_sources, g.reverse_sources().data(), m * sizeof(id_type));
+        if constexpr (!std::is_void_v<EdgePropType>) put(header.in_props, g.reverse_edge_prop_column().data(), m * sizeof(EdgePropType));
+    }
+    if constexpr (!std::is_void_v<NodePropType>) put(header.node_props, g.node_prop_column().data(), n * sizeof(NodePropType));
+    if (!out) throw std::runtime_error("write_graph_binary(): 写入失败 " + path);
+}
+
+
+template<typename NodeType=int, typename NodePropType=void, typename EdgePropType=void,
+    EdgeDirection edge_direction=EdgeDirection::UNDIRECTED>
+class MappedGraph{
+public:
+    using id_type = std::uint32_t;
+    using offset_type = std::uint64_t;
+    static constexpr id_type npos = std::numeric_limits<id_type>::max();
+    static constexpr offset_type npos_edge = std::numeric_limits<offset_type>::max();
+    static constexpr EdgeDirection direction = edge_direction;
+    using node_type = NodeType;
+    using node_prop_type = NodePropType;
+    using edge_prop_type = EdgePropType;
+
+private:
+    static_assert(graph_file_storable_v<NodeType>, "顶点类型必须平凡可拷贝!");
+    static_assert(graph_file_storable_v<NodePropType>, "顶点属性类型必须平凡可拷贝!");
+    static_assert(graph_file_storable_v<EdgePropType>, "边属性类型必须平凡可拷贝!");
+
+    using NodeProp = std::conditional_t<std::is_void_v<NodePropType>, empty_node_prop, NodePropType>;
+    using EdgeProp = std::conditional_t<std::is_void_v<EdgePropType>, empty_edge_prop, EdgePropType>;
+
+    const char* base = nullptr;
+    std::uint64_t length = 0;
+#if defined(_WIN32)
+    std::unique_ptr<std::uint64_t[]> buffer;
+#endif
+    GraphFileHeader header{};
+
+    const NodeType* node_arr = nullptr;
+    const id_type* sorted_arr = nullptr;
+    const offset_type* out_off = nullptr;
+    const id_type* out_tgt = nullptr;
+    const EdgeProp* out_prop = nullptr;
+    const offset_type* in_off = nullptr;
+    const id_type* in_src = nullptr;
+    const EdgeProp* in_prop = nullptr;
+    const NodeProp* node_prop_arr = nullptr;
+
+    template<typename T>
+    const T* section(std::uint64_t at, std::uint64_t count) const {
+        if (at == 0) return nullptr;
+        if (at % alignof(T) != 0 || at > length || count * sizeof(T) > length - at)
+            throw std::invalid_argument("MappedGraph: 文件段越界或未对齐!");
+        return reinterpret_cast<const T*>(base + at);
+    }
+
+    void release() noexcept {
+#if defined(_WIN32)
+        buffer.reset();
+#else
+        if (base) munmap(const_cast<char*>(base), length);
+#endif
+        base = nullptr;
+        length = 0;
+    }
+
+    void validate_and_bind(){
+        if (length < sizeof(GraphFileHeader)) throw std::invalid_argument("MappedGraph: 文件过短!");
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, graph_file_magic, sizeof(header.magic)) != 0) throw std::invalid_argument("MappedGraph: 不是图文件!");
+        if (header.endian != graph_file_endian) throw std::invalid_argument("MappedGraph: 文件的字节序与本机不一致!");
+        if (header.version != graph_file_version) throw std::invalid_argument("MappedGraph: 文件版本不受支持!");
+        if (header.directed != (edge_direction == EdgeDirection::DIRECTED)
+            || header.node_type != graph_file_type<NodeType>()
+            || header.node_prop_type != graph_file_type<NodePropType>()
+            || header.edge_prop_type != graph_file_type<EdgePropType>())
+            throw std::invalid_argument("MappedGraph: 文件的模板配置与当前类型不一致!");
+        if (header.file_size > length) throw std::invalid_argument("MappedGraph: 文件被截断!");
+        if (header.num_nodes >= npos) throw std::invalid_argument("MappedGraph: 顶点数超出 32 位 id 范围!");
+
+        const std::uint64_t n = header.num_nodes, m = header.num_arcs;
+        node_arr = section<NodeType>(header.nodes, n);
+        sorted_arr = section<id_type>(header.sorted_ids, n);
+        out_off = section<offset_type>(header.out_offsets, n + 1);
+        out_tgt = section<id_type>(header.out_targets, m);
+        if constexpr (!std::is_void_v<EdgePropType>) out_prop = section<EdgeProp>(header.out_props, m);
+        if constexpr (edge_direction == EdgeDirection::DIRECTED) {
+            in_off = section<offset_type>(header.in_offsets, n + 1);
+            in_src = section<id_type>(header.in_sources, m);
+            if constexpr (!std::is_void_v<EdgePropType>) in_prop = section<EdgeProp>(header.in_props, m);
+        } else {
+            in_off = out_off;
+            in_src = out_tgt;
+            in_prop = out_prop;
+        }
+        if constexpr (!std::is_void_v<NodePropType>) node_prop_arr = section<NodeProp>(header.node_props, n);
+        if (!out_off || !out_tgt || (n > 0 && (!node_arr || !sorted_arr)) || out_off[n] != m)
+            throw std::invalid_argument("MappedGraph: CSR 段缺失或不一致!");
+    }
+
+    // O(n+m) 的完整检查: 偏移单调且收尾于 m，顶点 id 都小于 n，sorted_ids 按顶点键严格升序
+    void verify_csr(const offset_type* off, const id_type* ids) const {
+        const std::uint64_t n = header.num_nodes, m = header.num_arcs;
+        if (off[0] != 0 || off[n] != m) throw std::invalid_argument("MappedGraph: CSR 偏移首尾不正确!");
+        for (std::uint64_t u = 0; u < n; ++u)
+            if (off[u] > off[u+1]) throw std::invalid_argument("MappedGraph: CSR 偏移不单调!");
+        for (std::uint64_t e = 0; e < m; ++e)
+            if (ids[e] >= n) throw std::invalid_argument("MappedGraph: 边端点 id 越界!");
+    }
+
+    void verify(){
+        const std::uint64_t n = header.num_nodes;
+        verify_csr(out_off, out_tgt);
+        if constexpr (edge_direction == EdgeDirection::DIRECTED) verify_csr(in_off, in_src);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            if (sorted_arr[i] >= n) throw std::invalid_argument("MappedGraph: sorted_ids 越界!");
+            if (i > 0 && !(node_arr[sorted_arr[i-1]] < node_arr[sorted_arr[i]]))
+                throw std::invalid_argument("MappedGraph: sorted_ids 未按顶点严格升序!");
+        }
+    }
+
+public:
+    MappedGraph() = default;
+
+    // verify 为 true 时额外做 O(n+m) 的完整检查，见文件头说明
+    explicit MappedGraph(const std::string& path, bool verify_contents = false){
+#if defined(_WIN32)
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("MappedGraph: 无法打开文件 " + path);
+        length = static_cast<std::uint64_t>(in.tellg());
+        buffer.reset(new std::uint64_t[(length + 7) / 8]);
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(buffer.get()), static_cast<std::streamsize>(length));
+        if (!in) throw std::runtime_error("MappedGraph: 读取失败 " + path);
+        base = reinterpret_cast<const char*>(buffer.get());
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("MappedGraph: 无法打开文件 " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MappedGraph: 无法读取文件大小 " + path);
+        }
+        length = static_cast<std::uint64_t>(st.st_size);
+        if (length > 0) {
+            void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (p == MAP_FAILED) throw std::runtime_error("MappedGraph: mmap 失败 " + path);
+            base = static_cast<const char*>(p);
+        } else {
+            ::close(fd);
+        }
+#endif
+        try {
+            validate_and_bind();
+            if (verify_contents) verify();
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    ~MappedGraph(){release();}
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    MappedGraph(MappedGraph&& other) noexcept {*this = std::move(other);}
+    MappedGraph& operator=(MappedGraph&& other) noexcept {
+        if (this != &other) {
+            release();
+            base = other.base; length = other.length;
+#if defined(_WIN32)
+            buffer = std::move(other.buffer);
+#endif
+            header = other.header;
+            node_arr = other.node_arr; sorted_arr = other.sorted_arr;
+            out_off = other.out_off; out_tgt = other.out_tgt; out_prop = other.out_prop;
+            in_off = other.in_off; in_src = other.in_src; in_prop = other.in_prop;
+            node_prop_arr = other.node_prop_arr;
+            other.base = nullptr;
+            other.length = 0;
+        }
+        return *this;
+    }
+
+    // 规模
+    id_type num_nodes() const noexcept {return static_cast<id_type>(header.num_nodes);}
+    offset_type num_arcs() const noexcept {return header.num_arcs;}
+    offset_type num_edges() const noexcept {
+        if constexpr (direction == EdgeDirection::UNDIRECTED) return (header.num_arcs + header.self_loops) / 2;
+        else return header.num_arcs;
+    }
+    offset_type num_self_loops() const noexcept {return header.self_loops;}
+
+    // 顶点与 id 互查，顶点 -> id 在 sorted_ids 上二分
+    id_type id_of(const NodeType& node) const {
+        auto last = sorted_arr + header.num_nodes;
+        auto it = std::lower_bound(sorted_arr, last, node, [this](id_type id, const NodeType& key){return node_arr[id] < key;});
+        return (it != last && !(node < node_arr[*it])) ? *it : npos;
+    }
+    bool has_node(const NodeType& node) const {return id_of(node) != npos;}
+    const NodeType& node_of(id_type id) const {return node_arr[id];}
+
+    // 度
+    offset_type out_degree(id_type u) const {return out_off[u+1] - out_off[u];}
+    offset_type in_degree(id_type u) const {return in_off[u+1] - in_off[u];}
+    offset_type degree(id_type u) const {
+        if constexpr (direction == EdgeDirection::DIRECTED) return out_degree(u) + in_degree(u);
+        else return out_degree(u);
+    }
+
+    // 邻居
+    CSRRange<id_type> out_neighbors(id_type u) const {return {out_tgt + out_off[u], out_tgt + out_off[u+1]};}
+    CSRRange<id_type> in_neighbors(id_type u) const {return {in_src + in_off[u], in_src + in_off[u+1]};}
+
+    // 属性
+    template<typename P = EdgePropType>
+    CSRRange<P> out_edge_props(id_type u) const {
+        static_assert(!std::is_void_v<EdgePropType>,"此图不存在边属性!");
+        return {out_prop + out_off[u], out_prop + out_off[u+1]};
+    }
+    template<typename P = EdgePropType>
+    CSRRange<P> in_edge_props(id_type u) const {
+        static_assert(!std::is_void_v<EdgePropType>,"此图不存在边属性!");
+        return {in_prop + in_off[u], in_prop + in_off[u+1]};
+    }
+    template<typename P = NodePropType>
+    const P& node_prop(id_type u) const {
+        static_assert(!std::is_void_v<NodePropType>,"此图不存在顶点属性!");
+        return node_prop_arr[u];
+    }
+
+    // 查边
+    offset_type edge_index(id_type u, id_type v) const {
+        auto first = out_tgt + out_off[u], last = out_tgt + out_off[u+1];
+        auto it = std::lower_bound(first, last, v);
+        return (it != last && *it == v) ? static_cast<offset_type>(it - out_tgt) : npos_edge;
+    }
+    bool has_edge(id_type u, id_type v) const {return edge_index(u, v) != npos_edge;}
+
+    // 拷贝成可独立存在的 CSRGraph
+    CSRGraph<NodeType, NodePropType, EdgePropType, edge_direction> to_csr() const {
+        using CSR = CSRGraph<NodeType, NodePropType, EdgePropType, edge_direction>;
+        const std::uint64_t n = header.num_nodes, m = header.num_arcs;
+        typename CSR::EdgePropColumn eprops{};
+        typename CSR::NodePropColumn nprops{};
+        if constexpr (!std::is_void_v<EdgePropType>) eprops.assign(out_prop, out_prop + m);
+        if constexpr (!std::is_void_v<NodePropType>) nprops.assign(node_prop_arr, node_prop_arr + n);
+        return CSR(std::vector<NodeType>(node_arr, node_arr + n), std::vector<offset_type>(out_off, out_off + n + 1),
+            std::vector<id_type>(out_tgt, out_tgt + m), std::move(eprops), std::move(nprops));
+    }
+};
+
+#endif
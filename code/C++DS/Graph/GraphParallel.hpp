@@ -0,0 +1,103 @@
+#ifndef GRAPHPARALLEL_HPP
+#define GRAPHPARALLEL_HPP
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// 引入MSVC的intrinsic头文件
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+#endif
+
+/**
+ * @file GraphParallel.hpp
+ * @brief 图算法共用的多线程工具，只依赖 std::thread。
+ *
+ * parallel_for(n, threads, body, grain):
+ *    - 把 [0, n) 切成长度为 grain 的块，threads 个线程通过原子计数器动态领取，
+ *      对度分布不均匀的图能自动负载均衡。
+ *    - body(begin, end, thread_index)，thread_index 在 [0, threads) 内，可用于索引线程私有缓冲。
+ *    - threads <= 1 或任务量不足一块时直接在调用线程中执行。
+ *
+ * parallel_sort(first, last, comp, threads):
+ *    - 切成 threads 段并行 std::sort，再逐轮两两 std::inplace_merge(同一轮的各对并行)。
+ *    - 元素较少或 threads <= 1 时退化为 std::sort。
+ *
+ * lowest_bit_index(block): 位图前沿扫描用的 ctz，兼容 MSVC。
+ */
+
+// 最低位 1 的下标，block 不能为 0
+inline int lowest_bit_index(std::uint64_t block){
+    #if defined(_MSC_VER) // MSVC
+        unsigned long bit_index;
+        _BitScanForward64(&bit_index, block);
+        return static_cast<int>(bit_index);
+    #else
+        return __builtin_ctzll(block);
+    #endif
+}
+
+// 默认线程数
+inline unsigned hardware_threads(){
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+template<typename F>
+void parallel_for(std::size_t n, unsigned threads, F&& body, std::size_t grain = 1024){
+    if (n == 0) return;
+    if (grain == 0) grain = 1;
+    std::size_t chunks = (n + grain - 1) / grain;
+    if (threads <= 1 || chunks <= 1) {
+        body(std::size_t(0), n, 0u);
+        return;
+    }
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, chunks));
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&](unsigned tid){
+        while (true) {
+            std::size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= n) break;
+            body(begin, std::min(n, begin + grain), tid);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+}
+
+template<typename RandomIt, typename Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp, unsigned threads = hardware_threads()){
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    if (threads <= 1 || n < (std::size_t(1) << 14)) {
+        std::sort(first, last, comp);
+        return;
+    }
+    const std::size_t parts = threads;
+    std::vector<std::size_t> bounds(parts + 1);
+    for (std::size_t i = 0; i <= parts; ++i) bounds[i] = n * i / parts;
+
+    parallel_for(parts, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t i = begin; i < end; ++i) std::sort(first + bounds[i], first + bounds[i + 1], comp);
+    }, 1);
+    for (std::size_t width = 1; width < parts; width *= 2) {
+        std::size_t pairs = (parts + 2 * width - 1) / (2 * width);
+        parallel_for(pairs, threads, [&](std::size_t begin, std::size_t end, unsigned){
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t lo = i * 2 * width, mid = std::min(lo + width, parts), hi = std::min(lo + 2 * width, parts);
+                if (mid < hi) std::inplace_merge(first + bounds[lo], first + bounds[mid], first + bounds[hi], comp);
+            }
+        }, 1);
+    }
+}
+
+#endif
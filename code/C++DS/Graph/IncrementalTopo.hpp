@@ -0,0 +1,358 @@
+#ifndef INCREMENTALTOPO_HPP
+#define INCREMENTALTOPO_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+#include "InternedGraph.hpp"
+
+/**
+ * @file IncrementalTopo.hpp
+ * @brief 有向无环图的在线拓扑序维护(Pearce-Kelly)与按层并行调度(Kahn 波前)。
+ *
+ * 每次 add_edge 之后整体重算拓扑序是 O(n + m)；增量算法只在新边违反当前顺序时做局部调整：
+ *
+ * 1. add_edge(from, to):
+ *    - ord(from) < ord(to)：顺序仍合法，直接插入，O(1)。
+ *    - 否则只有 ord 落在 [ord(to), ord(from)] 之间的顶点受影响(受影响区间 AR)：
+ *      从 to 沿出边 DFS，只访问 ord <= ord(from) 的顶点得到 deltaF，途中遇到 from 说明新边成环，拒绝插入；
+ *      再从 from 沿入边 DFS，只访问 ord > ord(to) 的顶点得到 deltaB；
+ *      把两组顶点原有的位置合并排序后，先按原相对顺序放 deltaB，再放 deltaF，AR 以外的顶点不动。
+ *    - 代价只与 AR 中被访问的顶点及其边数有关，构建依赖图这类大多数新边顺着现有顺序插入的场景接近 O(1)。
+ *
+ * 2. levels(threads) / run_levels(task, threads):
+ *    - Kahn 波前：入度为 0 的顶点组成第 0 层，整层删除后入度降为 0 的后继组成下一层；
+ *      层内各顶点互不依赖，入度用原子计数并行递减，恰好减到 0 的线程负责把后继放进下一层。
+ *    - run_levels 按层依次执行，层内并行调用 task(node)，相当于一次最大并行度的构建调度。
+ *
+ * 顶点键经 NodeInterner 映射为稠密 id，删除的 id 会被复用；ord 是顶点在位置数组 at 中的下标，
+ * 删除顶点只留下空位，不影响其余顶点的相对顺序，空位过多时整体压缩一次。
+ * 删除边和删除顶点不会破坏拓扑序，因此都是 O(度数)。不允许自环与重复边。
+ */
+
+enum class TopoInsert {INSERTED, EXISTS, MISSING_NODE, CYCLE};
+
+template<typename NodeType = int, typename Hasher = std::hash<NodeType>>
+class IncrementalTopoOrder {
+public:
+    using Interner = NodeInterner<NodeType, Hasher>;
+    using id_type = typename Interner::id_type;
+    static constexpr id_type npos = Interner::npos;
+
+private:
+    Interner interner;
+    std::vector<std::vector<id_type>> out_adj;
+    std::vector<std::vector<id_type>> in_adj;
+    std::vector<id_type> ord;   // ord[v]：v 在 at 中的位置
+    std::vector<id_type> at;    // at[p]：位置 p 上的顶点，npos 为空位
+    std::size_t edge_count = 0;
+
+    // DFS 标记与临时数组，按时间戳复用
+    std::vector<std::uint32_t> mark;
+    std::uint32_t epoch = 0;
+    std::vector<id_type> stack, delta_f, delta_b, slots;
+
+    void next_epoch(){
+        if (mark.size() < out_adj.size()) mark.resize(out_adj.size(), 0);
+        if (++epoch == 0) {
+            std::fill(mark.begin(), mark.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    static bool contains(const std::vector<id_type>& list, id_type v){
+        return std::find(list.begin(), list.end(), v) != list.end();
+    }
+
+    static void erase_one(std::vector<id_type>& list, id_type v){
+        auto it = std::find(list.begin(), list.end(), v);
+        if (it == list.end()) return;
+        *it = list.back();
+        list.pop_back();
+    }
+
+    // 从 to 出发沿出边访问 ord <= ub 的顶点，遇到 from 返回 false(成环)
+    bool forward_search(id_type to, id_type from, id_type ub){
+        delta_f.clear();
+        stack.assign(1, to);
+        mark[to] = epoch;
+        while (!stack.empty()) {
+            id_type u = stack.back();
+            stack.pop_back();
+            delta_f.emplace_back(u);
+            for (id_type w : out_adj[u]) {
+                if (w == from) return false;
+                if (mark[w] != epoch && ord[w] < ub) {
+                    mark[w] = epoch;
+                    stack.emplace_back(w);
+                }
+            }
+        }
+        return true;
+    }
+
+    // 从 from 出发沿入边访问 ord > lb 的顶点
+    void backward_search(id_type from, id_type lb){
+        delta_b.clear();
+        stack.assign(1, from);
+        mark[from] = epoch;
+        while (!stack.empty()) {
+            id_type u = stack.back();
+            stack.pop_back();
+            delta_b.emplace_back(u);
+            for (id_type w : in_adj[u]) {
+                if (mark[w] != epoch && ord[w] > lb) {
+                    mark[w] = epoch;
+                    stack.emplace_back(w);
+                }
+            }
+        }
+    }
+
+    // deltaB 整体移到 deltaF 之前，占用两组原有的位置
+    void reorder(){
+        auto by_ord = [&](id_type a, id_type b){return ord[a] < ord[b];};
+        std::sort(delta_b.begin(), delta_b.end(), by_ord);
+        std::sort(delta_f.begin(), delta_f.end(), by_ord);
+        slots.clear();
+        for (id_type v : delta_b) slots.emplace_back(ord[v]);
+        for (id_type v : delta_f) slots.emplace_back(ord[v]);
+        std::sort(slots.begin(), slots.end());
+        std::size_t i = 0;
+        for (id_type v : delta_b) {
+            ord[v] = slots[i++];
+            at[ord[v]] = v;
+        }
+        for (id_type v : delta_f) {
+            ord[v] = slots[i++];
+            at[ord[v]] = v;
+        }
+    }
+
+    // 空位超过一半时按当前顺序重新编号
+    void compact(){
+        std::size_t p = 0;
+        for (id_type v : at) {
+            if (v == npos) continue;
+            ord[v] = static_cast<id_type>(p);
+            at[p++] = v;
+        }
+        at.resize(p);
+    }
+
+    id_type new_node(const NodeType& node){
+        auto [id, inserted] = interner.intern(node);
+        if (!inserted) return npos;
+        if (id >= out_adj.size()) {
+            out_adj.resize(id + 1);
+            in_adj.resize(id + 1);
+            ord.resize(id + 1, npos);
+        }
+        if (at.size() >= npos) compact();
+        if (at.size() >= npos) throw std::length_error("IncrementalTopoOrder::add_node(): 顶点数超出 32 位 id 范围!");
+        ord[id] = static_cast<id_type>(at.size());
+        at.emplace_back(id);
+        return id;
+    }
+
+public:
+    IncrementalTopoOrder(std::size_t capacity = 32) : interner(capacity) {}
+
+    // 从有向 CSRGraph / MappedGraph / CompressedGraph 构建，图中有环时抛出 std::invalid_argument
+    template<typename CSR>
+    explicit IncrementalTopoOrder(const CSR& g) : interner(g.num_nodes()) {
+        static_assert(CSR::direction == EdgeDirection::DIRECTED, "拓扑序只对有向图有意义!");
+        using csr_id = typename CSR::id_type;
+        const csr_id n = g.num_nodes();
+        std::vector<std::uint64_t> indeg(n, 0);
+        for (csr_id u = 0; u < n; ++u) {
+            for (csr_id v : g.out_neighbors(u)) ++indeg[v];
+        }
+        std::vector<csr_id> queue;
+        queue.reserve(n);
+        for (csr_id u = 0; u < n; ++u) if (indeg[u] == 0) queue.emplace_back(u);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            for (csr_id v : g.out_neighbors(queue[head])) if (--indeg[v] == 0) queue.emplace_back(v);
+        }
+        if (queue.size() != n) throw std::invalid_argument("IncrementalTopoOrder: 图中存在环!");
+
+        // 按 Kahn 顺序分配 id，顺序天然合法，边直接追加
+        std::vector<id_type> id_of(n);
+        for (csr_id u : queue) id_of[u] = new_node(g.node_of(u));
+        for (csr_id u = 0; u < n; ++u) {
+            for (csr_id v : g.out_neighbors(u)) {
+                id_type a = id_of[u], b = id_of[v];
+                if (contains(out_adj[a], b)) continue;
+                out_adj[a].emplace_back(b);
+                in_adj[b].emplace_back(a);
+                ++edge_count;
+            }
+        }
+    }
+
+    std::size_t num_nodes() const noexcept {return interner.size();}
+    std::size_t num_edges() const noexcept {return edge_count;}
+    const Interner& nodes() const noexcept {return interner;}
+
+    bool has_node(const NodeType& node) const {return interner.find(node) != npos;}
+
+    bool has_edge(const NodeType& from, const NodeType& to) const {
+        id_type a = interner.find(from), b = interner.find(to);
+        return a != npos && b != npos && contains(out_adj[a], b);
+    }
+
+    // 返回是否新插入，新顶点排在当前顺序的末尾
+    int add_node(const NodeType& node){
+        return new_node(node) != npos;
+    }
+
+    template <typename... Args>
+    int add_node(const NodeType& node, const Args&... rest_nodes){
+        return add_node(node) + add_node(rest_nodes...);
+    }
+
+    // 不修改图，只判断插入 from -> to 是否会成环
+    bool would_create_cycle(const NodeType& from, const NodeType& to){
+        id_type a = interner.find(from), b = interner.find(to);
+        if (a == npos || b == npos) return false;
+        if (a == b) return true;
+        if (ord[a] < ord[b]) return false;
+        next_epoch();
+        return !forward_search(b, a, ord[a]);
+    }
+
+    TopoInsert add_edge(const NodeType& from, const NodeType& to){
+        id_type a = interner.find(from), b = interner.find(to);
+        if (a == npos || b == npos) return TopoInsert::MISSING_NODE;
+        if (a == b) return TopoInsert::CYCLE;
+        if (contains(out_adj[a], b)) return TopoInsert::EXISTS;
+        if (ord[b] < ord[a]) {
+            id_type lb = ord[b], ub = ord[a];
+            next_epoch();
+            if (!forward_search(b, a, ub)) return TopoInsert::CYCLE;
+            backward_search(a, lb);
+            reorder();
+        }
+        out_adj[a].emplace_back(b);
+        in_adj[b].emplace_back(a);
+        ++edge_count;
+        return TopoInsert::INSERTED;
+    }
+
+    int remove_edge(const NodeType& from, const NodeType& to){
+        id_type a = interner.find(from), b = interner.find(to);
+        if (a == npos || b == npos || !contains(out_adj[a], b)) return 0;
+        erase_one(out_adj[a], b);
+        erase_one(in_adj[b], a);
+        --edge_count;
+        return 1;
+    }
+
+    int remove_node(const NodeType& node){
+        id_type v = interner.find(node);
+        if (v == npos) return 0;
+        for (id_type w : out_adj[v]) erase_one(in_adj[w], v);
+        for (id_type w : in_adj[v]) erase_one(out_adj[w], v);
+        edge_count -= out_adj[v].size() + in_adj[v].size();
+        out_adj[v] = {};
+        in_adj[v] = {};
+        at[ord[v]] = npos;
+        ord[v] = npos;
+        interner.release(node);
+        if (at.size() > 64 && at.size() > 2 * interner.size()) compact();
+        return 1;
+    }
+
+    // u 在当前拓扑序中是否排在 v 之前
+    bool precedes(const NodeType& u, const NodeType& v) const {
+        id_type a = interner.find(u), b = interner.find(v);
+        if (a == npos || b == npos) throw std::out_of_range("IncrementalTopoOrder::precedes(): 顶点不存在!");
+        return ord[a] < ord[b];
+    }
+
+    // 当前拓扑序下的全部顶点
+    std::vector<NodeType> order() const {
+        std::vector<NodeType> result;
+        result.reserve(interner.size());
+        for (id_type v : at) if (v != npos) result.emplace_back(interner.key_of(v));
+        return result;
+    }
+
+    std::vector<NodeType> successors(const NodeType& node) const {
+        std::vector<NodeType> result;
+        id_type v = interner.find(node);
+        if (v == npos) return result;
+        for (id_type w : out_adj[v]) result.emplace_back(interner.key_of(w));
+        return result;
+    }
+
+    std::vector<NodeType> predecessors(const NodeType& node) const {
+        std::vector<NodeType> result;
+        id_type v = interner.find(node);
+        if (v == npos) return result;
+        for (id_type w : in_adj[v]) result.emplace_back(interner.key_of(w));
+        return result;
+    }
+
+    // Kahn 波前分层(以 id 表示)：同一层的顶点之间没有依赖
+    std::vector<std::vector<id_type>> level_ids(unsigned threads = hardware_threads()) const {
+        if (threads == 0) threads = 1;
+        const std::size_t bound = out_adj.size();
+        std::vector<std::atomic<std::uint32_t>> indeg(bound);
+        std::vector<std::vector<id_type>> local(threads);
+        parallel_for(bound, threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+            for (std::size_t v = begin; v < end; ++v) {
+                indeg[v].store(static_cast<std::uint32_t>(in_adj[v].size()), std::memory_order_relaxed);
+                if (in_adj[v].empty() && interner.contains(static_cast<id_type>(v))) local[tid].emplace_back(static_cast<id_type>(v));
+            }
+        }, 4096);
+
+        std::vector<std::vector<id_type>> result;
+        auto gather = [&](){
+            std::vector<id_type> level;
+            for (auto& l : local) {
+                level.insert(level.end(), l.begin(), l.end());
+                l.clear();
+            }
+            // 层内按拓扑序排列，结果与线程调度无关
+            std::sort(level.begin(), level.end(), [&](id_type a, id_type b){return ord[a] < ord[b];});
+            return level;
+        };
+
+        auto frontier = gather();
+        while (!frontier.empty()) {
+            parallel_for(frontier.size(), threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+                for (std::size_t i = begin; i < end; ++i) {
+                    for (id_type w : out_adj[frontier[i]]) {
+                        if (indeg[w].fetch_sub(1, std::memory_order_acq_rel) == 1) local[tid].emplace_back(w);
+                    }
+                }
+            }, 256);
+            result.emplace_back(std::move(frontier));
+            frontier = gather();
+        }
+        return result;
+    }
+
+    std::vector<std::vector<NodeType>> levels(unsigned threads = hardware_threads()) const {
+        std::vector<std::vector<NodeType>> result;
+        for (const auto& level : level_ids(threads)) {
+            auto& keys = result.emplace_back();
+            keys.reserve(level.size());
+            for (id_type v : level) keys.emplace_back(interner.key_of(v));
+        }
+        return result;
+    }
+
+    // 逐层执行 task(node)，层内并行；task 中抛出的异常会终止程序，调用方需自行捕获
+    template<typename Task>
+    void run_levels(Task&& task, unsigned threads = hardware_threads()) const {
+        if (threads == 0) threads = 1;
+        for (const auto& level : level_ids(threads)) {
+            parallel_for(level.size(), threads, [&](std::size_t begin, std::size_t end, unsigned){
+                for (std::size_t i = begin; i < end; ++i) task(interner.key_of(level[i]));
+            }, 1);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef INTERNEDGRAPH_HPP
+#define INTERNEDGRAPH_HPP
+
+#include "Graph.hpp"
+
+/**
+ * @file InternedGraph.hpp
+ * @brief 顶点驻留(interning)模式的图。
+ *
+ * 当 NodeType 为 std::string 或结构体时，Graph 的每次 add_edge 都要对完整的键做两次哈希，
+ * 并把键拷贝进每个邻居容器。InternedGraph 在顶点第一次出现时把键映射为 32 位 id，
+ * 内部只保存 Graph<uint32_t, ...>，边属性表也随之以 id 对为键。
+ *
+ * 1. NodeInterner<T, Hasher>:
+ *    - 键 <-> id 的双向映射，id 从 0 开始连续分配，删除的 id 会被回收复用。
+ *    - 键只在哈希表中保存一份，id -> 键 通过指向哈希表结点的指针完成。
+ *
+ * 2. InternedGraph<...>:
+ *    - 接口与 Graph 保持一致(按键操作)，另提供 *_by_id 系列直接按 id 操作。
+ *    - freeze() 返回以原始键为顶点的 CSRGraph。
+ */
+
+template <typename T, typename Hasher = std::hash<T>>
+class NodeInterner{
+public:
+    using id_type = std::uint32_t;
+    static constexpr id_type npos = std::numeric_limits<id_type>::max();
+
+private:
+    std::unordered_map<T, id_type, Hasher> key_to_id;
+    std::vector<const T*> id_to_key; // 指向 key_to_id 中的键，unordered_map 的结点地址在 rehash 后保持不变
+    std::vector<id_type> free_ids;
+
+public:
+    NodeInterner(std::size_t capacity = 32){
+        reserve(capacity);
+    }
+
+    void reserve(std::size_t capacity){
+        key_to_id.reserve(capacity);
+        id_to_key.reserve(capacity);
+    }
+
+    // 返回键对应的 id，键不存在时分配新 id
+    std::pair<id_type,bool> intern(const T& key){
+        auto it = key_to_id.find(key);
+        if (it != key_to_id.end()) return {it->second, false};
+        id_type id;
+        if (!free_ids.empty()) {
+            id = free_ids.back();
+            free_ids.pop_back();
+        } else {
+            if (id_to_key.size() >= npos) throw std::length_error("NodeInterner::intern(): 顶点数超出 32 位 id 范围!");
+            id = static_cast<id_type>(id_to_key.size());
+            id_to_key.emplace_back(nullptr);
+        }
+        auto inserted = key_to_id.emplace(key, id).first;
+        id_to_key[id] = &inserted->first;
+        return {id, true};
+    }
+
+    id_type find(const T& key) const {
+        auto it = key_to_id.find(key);
+        return it == key_to_id.end() ? npos : it->second;
+    }
+
+    bool contains(id_type id) const {return id < id_to_key.size() && id_to_key[id] != nullptr;}
+
+    const T& key_of(id_type id) const {
+        if (!contains(id)) throw std::out_of_range("NodeInterner::key_of(): id 不存在!");
+        return *id_to_key[id];
+    }
+
+    // 释放 id，之后可被新键复用
+    bool release(const T& key){
+        auto it = key_to_id.find(key);
+        if (it == key_to_id.end()) return false;
+        id_to_key[it->second] = nullptr;
+        free_ids.emplace_back(it->second);
+        key_to_id.erase(it);
+        return true;
+    }
+
+    std::size_t size() const noexcept {return key_to_id.size();}
+    std::size_t id_bound() const noexcept {return id_to_key.size();} // 已分配过的最大 id + 1
+};
+
+
+template<typename NodeType=int, typename NodePropType=void, typename EdgePropType=void,
+    EdgeDirection edge_direction=EdgeDirection::UNDIRECTED,
+    MultiEdge multi_edge=MultiEdge::DISALLOWED,
+    SelfLoop self_loop=SelfLoop::DISALLOWED,
+    Container neighbors_container_spec=Container::UNORDERED_SET,
+    typename Hasher=std::hash<NodeType>>
+class InternedGraph{
+public:
+    using Interner = NodeInterner<NodeType, Hasher>;
+    using id_type = typename Interner::id_type;
+    static constexpr id_type npos = Interner::npos;
+
+    // 内部以 id 为顶点的图，边属性表的键为 std::pair<id_type,id_type>
+    using IdGraph = Graph<id_type, NodePropType, EdgePropType, edge_direction, multi_edge, self_loop, Map::UNORDERED_MAP, neighbors_container_spec>;
+    using Frozen = CSRGraph<NodeType, NodePropType, EdgePropType, edge_direction, Map::UNORDERED_MAP>;
+
+private:
+    Interner interner;
+    IdGraph graph;
+
+    using NodePropArg = std::conditional_t<std::is_void_v<NodePropType>, empty_node_prop, NodePropType>;
+    using EdgePropArg = std::conditional_t<std::is_void_v<EdgePropType>, empty_edge_prop, EdgePropType>;
+
+public:
+    InternedGraph(std::size_t capacity = 32) : interner(capacity) {}
+
+    // id 互查
+    id_type id_of(const NodeType& node) const {return interner.find(node);}
+    const NodeType& key_of(id_type id) const {return interner.key_of(id);}
+    const Interner& nodes() const noexcept {return interner;}
+    const IdGraph& id_graph() const noexcept {return graph;}
+
+    // 添加无属性结点
+    int add_node(const NodeType& node){
+        static_assert((std::is_same_v<NodePropType,void>),"此图必须添加顶点属性!");
+        auto [id, inserted] = interner.intern(node);
+        if (inserted) graph.add_node(id);
+        return inserted;
+    }
+
+    template <typename... Args>
+    int add_node(const NodeType& node,const Args&... rest_nodes){
+        static_assert((std::is_convertible_v<Args,NodeType> && ...),"请保持添加的顶点具有正确的类型!");
+        int count = add_node(node);
+        if constexpr(sizeof...(Args)>0) {
+            count += add_node(rest_nodes...);
+        }
+        return count;
+    }
+
+    // 添加有属性顶点
+    int add_node_with_prop(const NodeType& node,const NodePropArg& nodeprop){
+        static_assert(!(std::is_same_v<NodePropType,void>),"此图不能添加顶点属性!");
+        auto [id, inserted] = interner.intern(node);
+        if (inserted) graph.add_node_with_prop(id, nodeprop);
+        return inserted;
+    }
+
+    // 添加边：每个端点只哈希一次，其余操作都在整数 id 上完成
+    int add_edge(const NodeType& outnode, const NodeType& innode){
+        return add_edge_by_id(interner.find(outnode), interner.find(innode));
+    }
+
+    int add_edge(const NodeType& outnode,const std::initializer_list<NodeType>& innodes){
+        id_type out = interner.find(outnode);
+        if (out == npos) return 0;
+        int count = 0;
+        for (auto& innode : innodes) count += add_edge_by_id(out, interner.find(innode));
+        return count;
+    }
+
+    int add_edge(const std::initializer_list<NodeType>& outnodes,const NodeType& innode){
+        id_type in = interner.find(innode);
+        if (in == npos) return 0;
+        int count = 0;
+        for (auto& outnode : outnodes) count += add_edge_by_id(interner.find(outnode), in);
+        return count;
+    }
+
+    int add_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropArg& edgeprop){
+        return add_edge_with_prop_by_id(interner.find(outnode), interner.find(innode), edgeprop);
+    }
+
+    int add_edge_by_id(id_type out, id_type in){
+        if (out == npos || in == npos) return 0;
+        return graph.add_edge(out, in);
+    }
+
+    int add_edge_with_prop_by_id(id_type out, id_type in, const EdgePropArg& edgeprop){
+        if (out == npos || in == npos) return 0;
+        return graph.add_edge_with_prop(out, in, edgeprop);
+    }
+
+    // 删除结点，id 交还驻留表复用
+    int remove_node(const NodeType& node){
+        id_type id = interner.find(node);
+        if (id == npos) return 0;
+        int removed = graph.remove_node(id);
+        interner.release(node);
+        return removed;
+    }
+
+    template <typename... Args>
+    int remove_node(const NodeType& node, const Args&... rest_nodes) {
+        static_assert((std::is_convertible_v<Args,NodeType> && ...),"请确认删除的顶点具有正确的类型!");
+        int count = remove_node(node);
+        if constexpr (sizeof...(Args) > 0) {
+            count += remove_node(rest_nodes...);
+        }
+        return count;
+    }
+
+    // 删除边
+    int remove_edge(const NodeType& outnode,const NodeType& innode){
+        id_type out = interner.find(outnode), in = interner.find(innode);
+        if (out == npos || in == npos) return 0;
+        return graph.remove_edge(out, in);
+    }
+
+    int remove_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropArg& edgeprop){
+        id_type out = interner.find(outnode), in = interner.find(innode);
+        if (out == npos || in == npos) return 0;
+        return graph.remove_edge_with_prop(out, in, edgeprop);
+    }
+
+    // 查找
+    bool has_node(const NodeType& node) const {return interner.find(node) != npos;}
+
+    std::optional<NodeInfo<NodeType,NodePropType>> find_node(const NodeType& node) const {
+        id_type id = interner.find(node);
+        if (id == npos) return std::nullopt;
+        auto info = graph.find_node(id);
+        if (!info) return std::nullopt;
+        return NodeInfo<NodeType,NodePropType>{interner.key_of(id), info->prop};
+    }
+
+    int has_edge(const NodeType& outnode,const NodeType& innode) const {
+        id_type out = interner.find(outnode), in = interner.find(innode);
+        if (out == npos || in == npos) return 0;
+        return graph.has_edge(out, in);
+    }
+
+    // 冻结为以原始键为顶点的 CSR 快照：按 id 冻结后把键换成原始键，CSR 数组直接移交，不再拷贝与排序
+    Frozen freeze() const {
+        auto csr = graph.freeze();
+        std::vector<NodeType> keys;
+        keys.reserve(csr.num_nodes());
+        for (id_type id : csr.nodes()) keys.emplace_back(interner.key_of(id));
+        return Frozen(std::move(keys), std::move(csr));
+    }
+};
+
+#endif
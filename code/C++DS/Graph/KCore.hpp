@@ -0,0 +1,185 @@
+#ifndef KCORE_HPP
+#define KCORE_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+
+/**
+ * @file KCore.hpp
+ * @brief k-core 分解与退化序(degeneracy ordering)，运行在 CSRGraph / MappedGraph / CompressedGraph 上。
+ *
+ * 顶点 v 的核数 core(v) 是包含 v 的最大 k-core 的 k；反复删去度最小的顶点得到的删除顺序即退化序，
+ * 每个顶点在序中排在它后面的邻居不超过退化度(= 最大核数)个，团枚举按此序可以大幅剪枝。
+ *
+ * 1. core_decomposition(g, mode):
+ *    - Batagelj-Zaversnik 桶算法：顶点按当前度放在 bin 中(vert/pos 数组原地维护)，
+ *      每次取出度最小的顶点，邻居的度减一时与所在 bin 的第一个顶点交换，O(n + m)。
+ *
+ * 2. parallel_core_decomposition(g, mode, threads):
+ *    - 按层并行剥离：第 k 层先并行收集当前度 <= k 的顶点作为前沿，整批删除后并行地原子递减邻居的度，
+ *      度从 k + 1 降到 k 的邻居进入下一批，直到本层没有顶点可删，再进入 k + 1 层。
+ *
+ * DegreeMode 指定有向图上计数的度：OUT 要求子图中每个顶点至少有 k 个出邻居，IN 为入邻居，TOTAL 为两者之和；
+ * 无向图三种模式相同。自环不计入度，重复边按条数计。
+ */
+
+enum class DegreeMode {OUT, IN, TOTAL};
+
+template<typename IdType>
+struct CoreResult {
+    std::vector<std::uint64_t> core;
+    std::vector<IdType> order;     // 退化序：按删除先后排列的顶点
+    std::uint64_t degeneracy;      // 最大核数
+};
+
+// 删除 v 时度会减少的顶点：OUT 模式下是 v 的前驱，IN 模式下是 v 的后继
+template<DegreeMode mode, typename CSR, typename F>
+void for_each_core_dependent(const CSR& g, typename CSR::id_type v, F&& f){
+    if constexpr (CSR::direction == EdgeDirection::UNDIRECTED) {
+        for (auto w : g.out_neighbors(v)) if (w != v) f(w);
+    } else {
+        if constexpr (mode != DegreeMode::IN) {
+            for (auto w : g.in_neighbors(v)) if (w != v) f(w);
+        }
+        if constexpr (mode != DegreeMode::OUT) {
+            for (auto w : g.out_neighbors(v)) if (w != v) f(w);
+        }
+    }
+}
+
+template<DegreeMode mode, typename CSR>
+std::uint64_t core_degree(const CSR& g, typename CSR::id_type v){
+    std::uint64_t d = 0;
+    if constexpr (CSR::direction == EdgeDirection::UNDIRECTED || mode != DegreeMode::IN) {
+        for (auto w : g.out_neighbors(v)) if (w != v) ++d;
+    }
+    if constexpr (CSR::direction == EdgeDirection::DIRECTED && mode != DegreeMode::OUT) {
+        for (auto w : g.in_neighbors(v)) if (w != v) ++d;
+    }
+    return d;
+}
+
+template<DegreeMode mode = DegreeMode::TOTAL, typename CSR>
+CoreResult<typename CSR::id_type> core_decomposition(const CSR& g){
+    using id_type = typename CSR::id_type;
+    const id_type n = g.num_nodes();
+    CoreResult<id_type> result{std::vector<std::uint64_t>(n), std::vector<id_type>(n), 0};
+    if (n == 0) return result;
+
+    auto& deg = result.core; // 原地演变为核数
+    std::uint64_t max_deg = 0;
+    for (id_type v = 0; v < n; ++v) {
+        deg[v] = core_degree<mode>(g, v);
+        max_deg = std::max(max_deg, deg[v]);
+    }
+
+    // bin[d] 为度为 d 的顶点在 vert 中的起始位置
+    std::vector<std::uint64_t> bin(max_deg + 2, 0);
+    for (id_type v = 0; v < n; ++v) ++bin[deg[v] + 1];
+    for (std::uint64_t d = 1; d < bin.size(); ++d) bin[d] += bin[d - 1];
+    auto& vert = result.order;
+    std::vector<std::uint64_t> pos(n);
+    {
+        std::vector<std::uint64_t> cursor(bin.begin(), bin.end() - 1);
+        for (id_type v = 0; v < n; ++v) {
+            pos[v] = cursor[deg[v]]++;
+            vert[pos[v]] = v;
+        }
+    }
+
+    for (std::uint64_t i = 0; i < n; ++i) {
+        id_type v = vert[i];
+        for_each_core_dependent<mode>(g, v, [&](id_type u){
+            if (deg[u] <= deg[v]) return;
+            // u 与其 bin 的第一个顶点交换，bin 起点后移，u 落入度减一的 bin
+            std::uint64_t du = deg[u], pu = pos[u], pw = bin[du];
+            id_type w = vert[pw];
+            if (u != w) {
+                pos[u] = pw;
+                vert[pw] = u;
+                pos[w] = pu;
+                vert[pu] = w;
+            }
+            ++bin[du];
+            --deg[u];
+        });
+        result.degeneracy = std::max(result.degeneracy, deg[v]);
+    }
+    return result;
+}
+
+template<DegreeMode mode = DegreeMode::TOTAL, typename CSR>
+CoreResult<typename CSR::id_type> parallel_core_decomposition(const CSR& g, unsigned threads = hardware_threads()){
+    using id_type = typename CSR::id_type;
+    const id_type n = g.num_nodes();
+    if (threads == 0) threads = 1;
+    CoreResult<id_type> result{std::vector<std::uint64_t>(n), {}, 0};
+    result.order.reserve(n);
+    if (n == 0) return result;
+
+    std::vector<std::atomic<std::uint64_t>> deg(n);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t v = begin; v < end; ++v) deg[v].store(core_degree<mode>(g, static_cast<id_type>(v)), std::memory_order_relaxed);
+    }, 1024);
+
+    std::vector<char> removed(n, 0);
+    std::vector<std::vector<id_type>> local(threads);
+    std::vector<id_type> frontier;
+    auto gather = [&](){
+        frontier.clear();
+        for (auto& l : local) {
+            frontier.insert(frontier.end(), l.begin(), l.end());
+            l.clear();
+        }
+    };
+
+    std::uint64_t k = 0;
+    while (result.order.size() < n) {
+        // 本层初始前沿：剩余顶点中度 <= k 的
+        parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+            for (std::size_t v = begin; v < end; ++v) {
+                if (!removed[v] && deg[v].load(std::memory_order_relaxed) <= k) local[tid].emplace_back(static_cast<id_type>(v));
+            }
+        }, 4096);
+        gather();
+
+        while (!frontier.empty()) {
+            for (id_type v : frontier) {
+                removed[v] = 1;
+                result.core[v] = k;
+            }
+            result.order.insert(result.order.end(), frontier.begin(), frontier.end());
+            parallel_for(frontier.size(), threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+                for (std::size_t i = begin; i < end; ++i) {
+                    for_each_core_dependent<mode>(g, frontier[i], [&](id_type u){
+                        if (removed[u]) return;
+                        // 恰好从 k + 1 降到 k 的线程负责把 u 放进下一批，度已 <= k 的顶点不再递减
+                        std::uint64_t cur = deg[u].load(std::memory_order_relaxed);
+                        while (cur > k) {
+                            if (deg[u].compare_exchange_weak(cur, cur - 1, std::memory_order_relaxed)) {
+                                if (cur == k + 1) local[tid].emplace_back(u);
+                                break;
+                            }
+                        }
+                    });
+                }
+            }, 256);
+            gather();
+        }
+        if (result.order.size() < n) ++k;
+    }
+    result.degeneracy = k;
+    return result;
+}
+
+// 核数 >= k 的顶点，即 k-core 的顶点集
+template<typename IdType>
+std::vector<IdType> k_core_members(const CoreResult<IdType>& cores, std::uint64_t k){
+    std::vector<IdType> members;
+    for (std::size_t v = 0; v < cores.core.size(); ++v) {
+        if (cores.core[v] >= k) members.emplace_back(static_cast<IdType>(v));
+    }
+    return members;
+}
+
+#endif
@@ -0,0 +1,415 @@
+#ifndef LOUVAIN_HPP
+#define LOUVAIN_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+#include "ShortestPath.hpp"
+
+/**
+ * @file Louvain.hpp
+ * @brief 多层 Louvain 社区发现(可选 Leiden 细化)，运行在 CSRGraph / MappedGraph / CompressedGraph 上。
+ *
+ * 优化目标为模块度 Q = sum_c [in_c / 2m - resolution * (tot_c / 2m)^2]，边权来自边属性，
+ * EdgePropType 为 void 时每条边权为 1；有向图按底图处理(两个方向的权相加)。
+ *
+ * 1. 局部移动(并行)：每个顶点统计邻居所在社区的连接权，移到增益最大的社区；社区总度 tot_c 用 CAS 原子更新，
+ *    多个线程同时扫描不同顶点。两个单点社区互相交换会来回振荡，因此单点之间只允许向编号更小的社区移动。
+ *    一轮扫描后模块度提升小于 tolerance 即结束本层。
+ * 2. 聚合：每个社区收缩成一个顶点，社区间的边权合并，社区内部的权变为自环，按社区并行构造紧凑的带权 CSR，
+ *    在新图上重复局部移动，直到没有顶点移动。
+ * 3. Leiden 细化(leiden_refinement = true)：聚合前在每个社区内部从单点出发重新合并，只合并与社区连接良好的
+ *    顶点和子社区，聚合以细化后的划分为顶点、以原社区为初始划分，保证得到的社区内部连通。
+ *    原论文按增益的指数分布随机选择合并目标，这里取增益最大者，结果是确定的；细化阶段在调用线程中执行。
+ *
+ * 并行局部移动的结果与线程调度有关，threads = 1 时与经典串行 Louvain 一致。
+ */
+
+struct LouvainOptions {
+    double resolution = 1.0;
+    double tolerance = 1e-7;          // 一轮扫描的模块度提升下限
+    std::size_t max_sweeps = 64;      // 每层局部移动的最多轮数
+    std::size_t max_levels = 32;
+    bool leiden_refinement = false;
+    unsigned threads = hardware_threads();
+};
+
+template<typename IdType>
+struct CommunityResult {
+    std::vector<IdType> community;    // 原图顶点的社区编号，[0, count)
+    IdType count;
+    double modularity;
+    std::size_t levels;
+};
+
+// 社区发现内部使用的对称带权 CSR，自环单独保存
+struct LouvainGraph {
+    std::vector<std::uint64_t> offsets{0};
+    std::vector<std::uint32_t> targets;
+    std::vector<double> weights;
+    std::vector<double> loops;        // 自环权(每条计一次)
+    std::vector<double> strength;     // 顶点的加权度，自环计两次
+    double total = 0;                 // 2m = sum strength
+
+    std::uint32_t num_nodes() const noexcept {return static_cast<std::uint32_t>(loops.size());}
+
+    void finish(unsigned threads){
+        const std::uint32_t n = num_nodes();
+        strength.assign(n, 0.0);
+        parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+            for (std::size_t v = begin; v < end; ++v) {
+                double k = 2 * loops[v];
+                for (std::uint64_t e = offsets[v]; e < offsets[v + 1]; ++e) k += weights[e];
+                strength[v] = k;
+            }
+        }, 1024);
+        total = 0;
+        for (double k : strength) total += k;
+    }
+};
+
+inline void louvain_atomic_add(std::atomic<double>& target, double delta){
+    double cur = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(cur, cur + delta, std::memory_order_relaxed)) {}
+}
+
+// 对 (社区, 权) 列表按社区排序并合并
+inline void louvain_merge_pairs(std::vector<std::pair<std::uint32_t, double>>& pairs){
+    std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b){return a.first < b.first;});
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        if (out > 0 && pairs[out - 1].first == pairs[i].first) pairs[out - 1].second += pairs[i].second;
+        else pairs[out++] = pairs[i];
+    }
+    pairs.resize(out);
+}
+
+template<typename CSR, typename WeightFn>
+LouvainGraph louvain_graph_from(const CSR& g, WeightFn weight, unsigned threads){
+    using id_type = typename CSR::id_type;
+    const id_type n = g.num_nodes();
+    auto arc_weight = [&weight](const auto& prop) -> double {
+        if constexpr (std::is_void_v<typename CSR::edge_prop_type>) return 1.0;
+        else return static_cast<double>(weight(prop));
+    };
+
+    LouvainGraph lg;
+    lg.loops.assign(n, 0.0);
+    std::vector<std::vector<std::pair<std::uint32_t, double>>> rows(n);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t ui = begin; ui < end; ++ui) {
+            id_type u = static_cast<id_type>(ui);
+            auto& row = rows[u];
+            auto visit = [&](id_type v, double w){
+                if (v == u) lg.loops[u] += w;
+                else row.emplace_back(v, w);
+            };
+            if constexpr (std::is_void_v<typename CSR::edge_prop_type>) {
+                for (id_type v : g.out_neighbors(u)) visit(v, 1.0);
+                if constexpr (CSR::direction == EdgeDirection::DIRECTED) {
+                    for (id_type v : g.in_neighbors(u)) if (v != u) visit(v, 1.0);
+                }
+            } else {
+                auto prop = g.out_edge_props(u).begin();
+                for (id_type v : g.out_neighbors(u)) visit(v, arc_weight(*prop++));
+                if constexpr (CSR::direction == EdgeDirection::DIRECTED) {
+                    auto in_prop = g.in_edge_props(u).begin();
+                    for (id_type v : g.in_neighbors(u)) {
+                        double w = arc_weight(*in_prop++);
+                        if (v != u) visit(v, w);
+                    }
+                }
+            }
+            louvain_merge_pairs(row);
+        }
+    }, 256);
+
+    for (id_type u = 0; u < n; ++u) lg.offsets.emplace_back(lg.offsets.back() + rows[u].size());
+    lg.targets.resize(lg.offsets.back());
+    lg.weights.resize(lg.offsets.back());
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t u = begin; u < end; ++u) {
+            std::uint64_t e = lg.offsets[u];
+            for (auto& [v, w] : rows[u]) {
+                lg.targets[e] = v;
+                lg.weights[e++] = w;
+            }
+            std::vector<std::pair<std::uint32_t, double>>().swap(rows[u]);
+        }
+    }, 1024);
+    lg.finish(threads);
+    return lg;
+}
+
+inline double louvain_modularity(const LouvainGraph& g, const std::vector<std::uint32_t>& comm, double resolution, unsigned threads){
+    const std::uint32_t n = g.num_nodes();
+    if (g.total <= 0) return 0.0;
+    std::vector<double> local_in(threads == 0 ? 1 : threads, 0.0);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+        double in = 0;
+        for (std::size_t v = begin; v < end; ++v) {
+            in += 2 * g.loops[v];
+            for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                if (comm[g.targets[e]] == comm[v]) in += g.weights[e];
+            }
+        }
+        local_in[tid] += in;
+    }, 1024);
+    double in = 0;
+    for (double x : local_in) in += x;
+    std::vector<double> tot(n, 0.0);
+    for (std::uint32_t v = 0; v < n; ++v) tot[comm[v]] += g.strength[v];
+    double sq = 0;
+    for (double t : tot) sq += (t / g.total) * (t / g.total);
+    return in / g.total - resolution * sq;
+}
+
+// 局部移动，comm 为初始划分(社区编号 < n)并被原地更新；返回是否有顶点移动
+inline bool louvain_local_move(const LouvainGraph& g, std::vector<std::uint32_t>& comm, const LouvainOptions& options){
+    const std::uint32_t n = g.num_nodes();
+    const unsigned threads = options.threads == 0 ? 1 : options.threads;
+    if (n == 0 || g.total <= 0) return false;
+    const double m2 = g.total, gamma = options.resolution;
+
+    std::vector<std::atomic<std::uint32_t>> label(n);
+    std::vector<std::atomic<double>> tot(n);
+    std::vector<std::atomic<std::uint32_t>> size(n);
+    for (std::uint32_t c = 0; c < n; ++c) {
+        tot[c].store(0.0, std::memory_order_relaxed);
+        size[c].store(0, std::memory_order_relaxed);
+    }
+    for (std::uint32_t v = 0; v < n; ++v) {
+        label[v].store(comm[v], std::memory_order_relaxed);
+        tot[comm[v]].store(tot[comm[v]].load(std::memory_order_relaxed) + g.strength[v], std::memory_order_relaxed);
+        size[comm[v]].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<std::vector<std::pair<std::uint32_t, double>>> scratch(threads);
+    bool any_moved = false;
+    double q = louvain_modularity(g, comm, gamma, threads);
+    for (std::size_t sweep = 0; sweep < options.max_sweeps; ++sweep) {
+        std::atomic<std::uint64_t> moves{0};
+        parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+            auto& links = scratch[tid];
+            for (std::size_t vi = begin; vi < end; ++vi) {
+                std::uint32_t v = static_cast<std::uint32_t>(vi);
+                std::uint32_t own = label[v].load(std::memory_order_relaxed);
+                double kv = g.strength[v];
+                links.clear();
+                links.emplace_back(own, 0.0);
+                for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                    links.emplace_back(label[g.targets[e]].load(std::memory_order_relaxed), g.weights[e]);
+                }
+                louvain_merge_pairs(links);
+
+                // 增益 = w(v, c) - gamma * kv * tot_c / 2m，tot_c 不含 v 自身
+                std::uint32_t best = own;
+                double best_gain = 0;
+                for (auto& [c, w] : links) {
+                    double t = tot[c].load(std::memory_order_relaxed) - (c == own ? kv : 0.0);
+                    double gain = w - gamma * kv * t / m2;
+                    if (c == own) {
+                        best_gain = gain;
+                        break;
+                    }
+                }
+                for (auto& [c, w] : links) {
+                    if (c == own) continue;
+                    double gain = w - gamma * kv * tot[c].load(std::memory_order_relaxed) / m2;
+                    if (gain > best_gain + 1e-12 || (gain == best_gain && best != own && c < best)) {
+                        best_gain = gain;
+                        best = c;
+                    }
+                }
+                if (best == own) continue;
+                // 单点社区之间只向编号更小的一方移动，避免两个顶点互换
+                if (size[own].load(std::memory_order_relaxed) == 1 && size[best].load(std::memory_order_relaxed) == 1 && best > own) continue;
+
+                louvain_atomic_add(tot[own], -kv);
+                louvain_atomic_add(tot[best], kv);
+                size[own].fetch_sub(1, std::memory_order_relaxed);
+                size[best].fetch_add(1, std::memory_order_relaxed);
+                label[v].store(best, std::memory_order_relaxed);
+                moves.fetch_add(1, std::memory_order_relaxed);
+            }
+        }, 512);
+
+        if (moves.load() == 0) break;
+        any_moved = true;
+        for (std::uint32_t v = 0; v < n; ++v) comm[v] = label[v].load(std::memory_order_relaxed);
+        double next_q = louvain_modularity(g, comm, gamma, threads);
+        if (next_q - q < options.tolerance) break;
+        q = next_q;
+    }
+    return any_moved;
+}
+
+// Leiden 细化：在每个社区内部从单点出发，只合并连接良好的顶点与子社区
+inline std::vector<std::uint32_t> louvain_refine(const LouvainGraph& g, const std::vector<std::uint32_t>& comm, double gamma){
+    const std::uint32_t n = g.num_nodes();
+    const double m2 = g.total;
+    std::vector<std::uint32_t> refined(n);
+    std::vector<double> rtot(g.strength), ext(n, 0.0), comm_tot(n, 0.0);
+    std::vector<std::uint32_t> rsize(n, 1);
+    for (std::uint32_t v = 0; v < n; ++v) {
+        refined[v] = v;
+        comm_tot[comm[v]] += g.strength[v];
+    }
+    // ext[R]：子社区 R 连向同社区其余部分的权
+    for (std::uint32_t v = 0; v < n; ++v) {
+        for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+            if (comm[g.targets[e]] == comm[v]) ext[v] += g.weights[e];
+        }
+    }
+
+    std::vector<std::pair<std::uint32_t, double>> links;
+    for (std::uint32_t v = 0; v < n; ++v) {
+        if (rsize[refined[v]] != 1) continue;
+        double kv = g.strength[v], ts = comm_tot[comm[v]];
+        if (ext[v] < gamma * kv * (ts - kv) / m2) continue; // v 与所在社区连接不够紧密
+
+        links.clear();
+        for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+            std::uint32_t u = g.targets[e];
+            if (comm[u] == comm[v] && refined[u] != refined[v]) links.emplace_back(refined[u], g.weights[e]);
+        }
+        louvain_merge_pairs(links);
+
+        std::uint32_t best = refined[v];
+        double best_gain = 0;
+        for (auto& [r, w] : links) {
+            if (ext[r] < gamma * rtot[r] * (ts - rtot[r]) / m2) continue; // 目标子社区连接不够紧密
+            double gain = w - gamma * kv * rtot[r] / m2;
+            if (gain > best_gain) {
+                best_gain = gain;
+                best = r;
+            }
+        }
+        if (best == refined[v]) continue;
+
+        double w_to_best = 0;
+        for (auto& [r, w] : links) if (r == best) w_to_best = w;
+        std::uint32_t own = refined[v];
+        ext[best] += ext[own] - 2 * w_to_best;
+        rtot[best] += kv;
+        ++rsize[best];
+        rtot[own] = 0;
+        rsize[own] = 0;
+        refined[v] = best;
+    }
+    return refined;
+}
+
+// 把编号压缩到 [0, count)，返回 count
+inline std::uint32_t louvain_compact(std::vector<std::uint32_t>& labels){
+    std::uint32_t bound = 0;
+    for (auto c : labels) bound = std::max(bound, c + 1);
+    std::vector<std::uint32_t> remap(bound, std::numeric_limits<std::uint32_t>::max());
+    std::uint32_t count = 0;
+    for (auto& c : labels) {
+        if (remap[c] == std::numeric_limits<std::uint32_t>::max()) remap[c] = count++;
+        c = remap[c];
+    }
+    return count;
+}
+
+// 按划分 part(已压缩到 [0, count))聚合成新图
+inline LouvainGraph louvain_aggregate(const LouvainGraph& g, const std::vector<std::uint32_t>& part, std::uint32_t count, unsigned threads){
+    const std::uint32_t n = g.num_nodes();
+    std::vector<std::uint64_t> start(static_cast<std::size_t>(count) + 1, 0);
+    for (std::uint32_t v = 0; v < n; ++v) ++start[part[v] + 1];
+    for (std::uint32_t c = 0; c < count; ++c) start[c + 1] += start[c];
+    std::vector<std::uint32_t> members(n);
+    {
+        std::vector<std::uint64_t> cursor(start.begin(), start.end() - 1);
+        for (std::uint32_t v = 0; v < n; ++v) members[cursor[part[v]]++] = v;
+    }
+
+    LouvainGraph h;
+    h.loops.assign(count, 0.0);
+    std::vector<std::vector<std::pair<std::uint32_t, double>>> rows(count);
+    parallel_for(count, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t c = begin; c < end; ++c) {
+            auto& row = rows[c];
+            double internal = 0;
+            for (std::uint64_t i = start[c]; i < start[c + 1]; ++i) {
+                std::uint32_t v = members[i];
+                h.loops[c] += g.loops[v];
+                for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                    std::uint32_t d = part[g.targets[e]];
+                    if (d == c) internal += g.weights[e];
+                    else row.emplace_back(d, g.weights[e]);
+                }
+            }
+            h.loops[c] += internal / 2; // 内部边在两端各出现一次
+            louvain_merge_pairs(row);
+        }
+    }, 64);
+
+    for (std::uint32_t c = 0; c < count; ++c) h.offsets.emplace_back(h.offsets.back() + rows[c].size());
+    h.targets.resize(h.offsets.back());
+    h.weights.resize(h.offsets.back());
+    parallel_for(count, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t c = begin; c < end; ++c) {
+            std::uint64_t e = h.offsets[c];
+            for (auto& [d, w] : rows[c]) {
+                h.targets[e] = d;
+                h.weights[e++] = w;
+            }
+        }
+    }, 1024);
+    h.finish(threads);
+    return h;
+}
+
+template<typename CSR, typename WeightFn = IdentityWeight>
+CommunityResult<typename CSR::id_type> louvain(const CSR& g, const LouvainOptions& options = {}, WeightFn weight = {}){
+    using id_type = typename CSR::id_type;
+    const unsigned threads = options.threads == 0 ? 1 : options.threads;
+    const id_type n = g.num_nodes();
+
+    LouvainGraph level = louvain_graph_from(g, weight, threads);
+    const LouvainGraph* base = nullptr;
+    LouvainGraph original;
+
+    std::vector<std::uint32_t> member(n);   // 原图顶点 -> 当前层顶点
+    for (id_type v = 0; v < n; ++v) member[v] = v;
+    std::vector<std::uint32_t> comm(n);     // 当前层顶点 -> 社区
+    for (id_type v = 0; v < n; ++v) comm[v] = v;
+
+    CommunityResult<id_type> result{std::vector<id_type>(n), 0, 0.0, 0};
+    for (std::size_t lv = 0; lv < options.max_levels; ++lv) {
+        bool moved = louvain_local_move(level, comm, options);
+        result.levels = lv + 1;
+        if (!moved) break;
+
+        std::vector<std::uint32_t> part = options.leiden_refinement ? louvain_refine(level, comm, options.resolution) : comm;
+        std::uint32_t count = louvain_compact(part);
+        LouvainGraph next = louvain_aggregate(level, part, count, threads);
+
+        for (auto& m : member) m = part[m];
+        std::vector<std::uint32_t> next_comm(count);
+        for (std::uint32_t v = 0; v < level.num_nodes(); ++v) next_comm[part[v]] = comm[v];
+        louvain_compact(next_comm);
+        if (!options.leiden_refinement) {
+            for (std::uint32_t c = 0; c < count; ++c) next_comm[c] = c;
+        }
+
+        bool shrunk = count < level.num_nodes();
+        if (lv == 0) {
+            original = std::move(level);
+            base = &original;
+        }
+        level = std::move(next);
+        comm = std::move(next_comm);
+        if (!shrunk) break;
+    }
+
+    std::vector<std::uint32_t> final_comm(n);
+    for (id_type v = 0; v < n; ++v) final_comm[v] = comm[member[v]];
+    result.count = louvain_compact(final_comm);
+    for (id_type v = 0; v < n; ++v) result.community[v] = final_comm[v];
+    result.modularity = louvain_modularity(base ? *base : level, final_comm, options.resolution, threads);
+    return result;
+}
+
+#endif
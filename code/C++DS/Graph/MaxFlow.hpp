@@ -0,0 +1,312 @@
+#ifndef MAXFLOW_HPP
+#define MAXFLOW_HPP
+
+#include "Graph.hpp"
+#include "ShortestPath.hpp"
+
+/**
+ * @file MaxFlow.hpp
+ * @brief 最高标号预流推进(HLPP)最大流 / 最小割，运行在 CSRGraph / MappedGraph / CompressedGraph 上，容量来自边属性。
+ *
+ * 1. 残量 CSR：每条弧 u -> v 在 u 行放一条正向弧(残量 = 容量)，在 v 行放一条反向弧(残量 = 0)，
+ *    两者用 rev 下标互指；一行的弧连续存放，推流时顺序扫描，不经过哈希表。
+ *    无向图的每条边在两端各出现一次，因此两个方向各有一份容量。
+ *
+ * 2. 第一阶段求最大预流：
+ *    - 总是从标号最高的活跃顶点开始排出(discharge)，活跃顶点按标号分桶；
+ *    - 全局重标号：从汇点在残量图上反向 BFS 得到精确距离标号，开始时做一次，之后每做约 n + m 的重标号工作量再做一次；
+ *    - 间隙优化：某个标号 h 上不再有顶点时，标号高于 h 的顶点都不可能再到达汇点，直接把标号抬到 n 退出。
+ *    阶段结束时汇点的盈余即最大流值，此时已可求最小割。
+ *
+ * 3. 第二阶段把滞留在标号 >= n 的顶点上的盈余推回源点(同样的排出过程，目标换成源点)，
+ *    得到满足流量守恒的可行流，flow 与原图的弧一一对应。
+ *
+ * PushRelabel 保存残量图，可对不同的 (s, t) 反复求解；max_flow / min_cut 是一次性的便捷接口。
+ * 容量应为整数类型；浮点容量可以使用，但比较残量是否为 0 时不做容差处理。
+ */
+
+template<typename IdType, typename W>
+struct MaxFlowResult {
+    W value;
+    std::vector<W> flow;            // 原图每条弧(按弧下标)上的流量
+    std::vector<char> source_side;  // 最小割中源点一侧的顶点
+};
+
+template<typename IdType, typename W>
+struct MinCutResult {
+    W value;
+    std::vector<char> source_side;
+    std::vector<std::pair<IdType, IdType>> cut_edges; // 从源点一侧指向汇点一侧的饱和弧
+};
+
+template<typename IdType, typename W>
+class PushRelabel {
+public:
+    using id_type = IdType;
+    using offset_type = std::uint64_t;
+
+private:
+    id_type n = 0;
+    std::vector<offset_type> offsets;
+    std::vector<id_type> head;          // 弧的终点
+    std::vector<offset_type> rev;       // 反向弧下标
+    std::vector<W> capacity;            // 原始容量(反向弧为 0)
+    std::vector<W> residual;
+    std::vector<offset_type> forward;   // 原图弧下标 -> 残量图正向弧下标
+    std::vector<std::pair<id_type, id_type>> endpoints; // 原图弧的两端
+
+    // 求解期间的状态
+    std::vector<W> excess;
+    std::vector<id_type> height;
+    std::vector<offset_type> current;
+    std::vector<std::vector<id_type>> active;             // 按标号分桶的活跃顶点(懒删除)
+    std::vector<id_type> level_head, level_next, level_prev; // 按标号分桶的所有顶点(双向链表，用于间隙优化)
+    id_type max_active = 0, max_level = 0;
+    offset_type work = 0;
+
+    static constexpr id_type nil = std::numeric_limits<id_type>::max();
+
+    void level_insert(id_type v, id_type h){
+        level_prev[v] = nil;
+        level_next[v] = level_head[h];
+        if (level_head[h] != nil) level_prev[level_head[h]] = v;
+        level_head[h] = v;
+        if (h > max_level) max_level = h;
+    }
+
+    void level_remove(id_type v, id_type h){
+        if (level_prev[v] != nil) level_next[level_prev[v]] = level_next[v];
+        else level_head[h] = level_next[v];
+        if (level_next[v] != nil) level_prev[level_next[v]] = level_prev[v];
+    }
+
+    void activate(id_type v){
+        id_type h = height[v];
+        if (h >= n) return;
+        active[h].emplace_back(v);
+        if (h > max_active) max_active = h;
+    }
+
+    // 从 target 在残量图上反向 BFS，重建标号与两类桶；fixed 的标号固定为 n
+    void global_relabel(id_type target, id_type fixed){
+        std::fill(height.begin(), height.end(), n);
+        for (auto& bucket : active) bucket.clear();
+        std::fill(level_head.begin(), level_head.end(), nil);
+        max_active = max_level = 0;
+        work = 0;
+
+        std::vector<id_type> queue{target};
+        height[target] = 0;
+        for (std::size_t qi = 0; qi < queue.size(); ++qi) {
+            id_type u = queue[qi];
+            for (offset_type a = offsets[u]; a < offsets[u+1]; ++a) {
+                id_type w = head[a];
+                if (height[w] == n && w != fixed && residual[rev[a]] > W(0)) {
+                    height[w] = height[u] + 1;
+                    queue.emplace_back(w);
+                }
+            }
+        }
+        for (id_type v : queue) {
+            if (v == target) continue;
+            level_insert(v, height[v]);
+            current[v] = offsets[v];
+            if (excess[v] > W(0)) activate(v);
+        }
+    }
+
+    void push(offset_type a, id_type u, W amount, id_type target, id_type fixed){
+        id_type w = head[a];
+        residual[a] -= amount;
+        residual[rev[a]] += amount;
+        bool was_idle = !(excess[w] > W(0));
+        excess[u] -= amount;
+        excess[w] += amount;
+        if (was_idle && w != target && w != fixed) activate(w);
+    }
+
+    // 标号 h 上已无顶点：高于 h 的顶点全部退出
+    void gap(id_type h){
+        for (id_type k = h + 1; k <= max_level; ++k) {
+            for (id_type v = level_head[k]; v != nil; v = level_next[v]) height[v] = n;
+            level_head[k] = nil;
+        }
+        max_level = h > 0 ? h - 1 : 0;
+    }
+
+    void discharge(id_type u, id_type target, id_type fixed){
+        while (excess[u] > W(0)) {
+            offset_type last = offsets[u+1];
+            offset_type& a = current[u];
+            for (; a < last; ++a) {
+                if (residual[a] > W(0) && height[head[a]] + 1 == height[u]) {
+                    push(a, u, std::min(excess[u], residual[a]), target, fixed);
+                    if (!(excess[u] > W(0))) return;
+                }
+            }
+
+            // 重标号
+            id_type old = height[u], lowest = n;
+            for (offset_type b = offsets[u]; b < last; ++b) {
+                if (residual[b] > W(0) && height[head[b]] < lowest) lowest = height[head[b]];
+            }
+            work += last - offsets[u] + 12;
+            level_remove(u, old);
+            if (level_head[old] == nil) {
+                gap(old);
+                height[u] = n;
+                return;
+            }
+            height[u] = lowest >= n ? n : lowest + 1;
+            if (height[u] >= n) return;
+            current[u] = offsets[u];
+            level_insert(u, height[u]);
+        }
+    }
+
+    // 以 target 为汇点排出所有活跃顶点
+    void run(id_type target, id_type fixed){
+        const offset_type m = head.size();
+        global_relabel(target, fixed);
+        while (true) {
+            while (max_active > 0 && active[max_active].empty()) --max_active;
+            if (active[max_active].empty()) break;
+            id_type h = max_active;
+            id_type u = active[h].back();
+            active[h].pop_back();
+            if (height[u] != h || !(excess[u] > W(0))) continue;
+            discharge(u, target, fixed);
+            if (work > 6 * static_cast<offset_type>(n) + m) global_relabel(target, fixed);
+        }
+    }
+
+public:
+    PushRelabel()=default;
+
+    template<typename CSR, typename CapacityFn = IdentityWeight>
+    explicit PushRelabel(const CSR& g, CapacityFn cap = {}){
+        static_assert(std::is_same_v<typename CSR::id_type, IdType>, "id 类型不匹配!");
+        static_assert(std::is_arithmetic_v<W>, "容量必须是数值类型!");
+        n = g.num_nodes();
+        std::vector<offset_type> degree(n, 0);
+        for (id_type u = 0; u < n; ++u) {
+            for (id_type v : g.out_neighbors(u)) {
+                ++degree[u];
+                ++degree[v];
+            }
+        }
+        offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+        for (id_type u = 0; u < n; ++u) offsets[u+1] = offsets[u] + degree[u];
+        const offset_type arcs = offsets[n];
+        head.resize(arcs);
+        rev.resize(arcs);
+        capacity.assign(arcs, W(0));
+        forward.reserve(g.num_arcs());
+        endpoints.reserve(g.num_arcs());
+
+        std::vector<offset_type> cursor(offsets.begin(), offsets.end() - 1);
+        for (id_type u = 0; u < n; ++u) {
+            auto prop = g.out_edge_props(u).begin();
+            for (id_type v : g.out_neighbors(u)) {
+                W c = static_cast<W>(cap(*prop++));
+                if (c < W(0)) throw std::invalid_argument("PushRelabel: 存在负容量边!");
+                offset_type a = cursor[u]++, b = cursor[v]++;
+                head[a] = v;
+                head[b] = u;
+                rev[a] = b;
+                rev[b] = a;
+                capacity[a] = c;
+                forward.emplace_back(a);
+                endpoints.emplace_back(u, v);
+            }
+        }
+
+        excess.resize(n);
+        height.resize(n);
+        current.resize(n);
+        active.resize(static_cast<std::size_t>(n) + 1);
+        level_head.resize(static_cast<std::size_t>(n) + 1);
+        level_next.resize(n);
+        level_prev.resize(n);
+    }
+
+    id_type num_nodes() const noexcept {return n;}
+
+    // 求 s -> t 的最大流，返回流值；之后可用 flow()、source_side() 读取结果
+    W solve(id_type s, id_type t){
+        if (s >= n || t >= n) throw std::out_of_range("PushRelabel::solve(): 源点或汇点不存在!");
+        if (s == t) throw std::invalid_argument("PushRelabel::solve(): 源点与汇点不能相同!");
+        residual = capacity;
+        std::fill(excess.begin(), excess.end(), W(0));
+
+        // 从源点饱和推出
+        for (offset_type a = offsets[s]; a < offsets[s+1]; ++a) {
+            W c = residual[a];
+            if (!(c > W(0))) continue;
+            residual[a] -= c;
+            residual[rev[a]] += c;
+            excess[head[a]] += c;
+            excess[s] -= c;
+        }
+        run(t, s);           // 第一阶段：最大预流
+        W value = excess[t];
+        run(s, t);           // 第二阶段：剩余盈余退回源点
+        return value;
+    }
+
+    // 原图每条弧上的流量
+    std::vector<W> flow() const {
+        std::vector<W> f(forward.size());
+        for (std::size_t e = 0; e < forward.size(); ++e) f[e] = capacity[forward[e]] - residual[forward[e]];
+        return f;
+    }
+
+    // 最小割源点一侧：残量图中从 s 可达的顶点
+    std::vector<char> source_side(id_type s) const {
+        std::vector<char> side(n, 0);
+        std::vector<id_type> stack{s};
+        side[s] = 1;
+        while (!stack.empty()) {
+            id_type u = stack.back();
+            stack.pop_back();
+            for (offset_type a = offsets[u]; a < offsets[u+1]; ++a) {
+                id_type w = head[a];
+                if (!side[w] && residual[a] > W(0)) {
+                    side[w] = 1;
+                    stack.emplace_back(w);
+                }
+            }
+        }
+        return side;
+    }
+
+    // 跨越割的原图弧
+    std::vector<std::pair<id_type, id_type>> cut_edges(const std::vector<char>& side) const {
+        std::vector<std::pair<id_type, id_type>> cut;
+        for (std::size_t e = 0; e < endpoints.size(); ++e) {
+            auto [u, v] = endpoints[e];
+            if (side[u] && !side[v] && capacity[forward[e]] > W(0)) cut.emplace_back(u, v);
+        }
+        return cut;
+    }
+};
+
+template<typename CSR, typename CapacityFn = IdentityWeight>
+MaxFlowResult<typename CSR::id_type, edge_weight_t<CSR, CapacityFn>>
+max_flow(const CSR& g, typename CSR::id_type s, typename CSR::id_type t, CapacityFn cap = {}){
+    PushRelabel<typename CSR::id_type, edge_weight_t<CSR, CapacityFn>> engine(g, cap);
+    auto value = engine.solve(s, t);
+    return {value, engine.flow(), engine.source_side(s)};
+}
+
+template<typename CSR, typename CapacityFn = IdentityWeight>
+MinCutResult<typename CSR::id_type, edge_weight_t<CSR, CapacityFn>>
+min_cut(const CSR& g, typename CSR::id_type s, typename CSR::id_type t, CapacityFn cap = {}){
+    PushRelabel<typename CSR::id_type, edge_weight_t<CSR, CapacityFn>> engine(g, cap);
+    auto value = engine.solve(s, t);
+    auto side = engine.source_side(s);
+    auto cut = engine.cut_edges(side);
+    return {value, std::move(side), std::move(cut)};
+}
+
+#endif
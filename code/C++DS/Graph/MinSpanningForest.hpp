@@ -0,0 +1,232 @@
+#ifndef MINSPANNINGFOREST_HPP
+#define MINSPANNINGFOREST_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+#include "ShortestPath.hpp"
+#include "../Tree/UnionFind.hpp"
+#include <random>
+
+/**
+ * @file MinSpanningForest.hpp
+ * @brief 最小生成森林，运行在 CSRGraph / MappedGraph / CompressedGraph 上，边权来自边属性。
+ *
+ * 两种算法先把图展开为边表(无向图每条边只取 u < v 的一侧，有向图按底图处理，自环丢弃)，
+ * 边的全序为 (权, 边表下标)，权相同时结果也是确定的，且 Boruvka 不会成环。
+ *
+ * 1. boruvka_msf(g, weight, threads):
+ *    - 每轮多个线程并行扫描边表，对两端所在分量各用 CAS 记录最轻的出边；
+ *      随后在调用线程中把这些边合并进 UnionFind<int> 并收入森林；
+ *    - 压缩分量编号后并行过滤掉两端已在同一分量的边；分量数每轮至少减半，O(log n) 轮结束。
+ *
+ * 2. filter_kruskal_msf(g, weight, threads):
+ *    - Filter-Kruskal：按抽样的中位数把边分成轻、重两半，先递归处理轻边，
+ *      再滤掉两端已连通的重边后递归处理剩余部分；规模小于阈值时 parallel_sort 后直接 Kruskal。
+ *    - 大量重边在排序前就被滤掉，稠密图上明显快于先整体排序的 Kruskal。
+ *
+ * 返回森林的边表(稠密 id 与边权)、总权与树的棵数(孤立顶点各算一棵)。
+ */
+
+template<typename IdType, typename W>
+struct WeightedEdge {
+    IdType u, v;
+    W weight;
+};
+
+template<typename IdType, typename W>
+struct SpanningForest {
+    std::vector<WeightedEdge<IdType, W>> edges;
+    W total_weight;
+    IdType trees;
+};
+
+// 展开为边表：先按行计数，再并行回填
+template<typename CSR, typename WeightFn>
+std::vector<WeightedEdge<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>>
+collect_weighted_edges(const CSR& g, WeightFn weight, unsigned threads){
+    using id_type = typename CSR::id_type;
+    using W = edge_weight_t<CSR, WeightFn>;
+    static_assert(std::is_arithmetic_v<W>, "边权必须是数值类型!");
+    const id_type n = g.num_nodes();
+    auto keep = [](id_type u, id_type v){
+        if constexpr (CSR::direction == EdgeDirection::UNDIRECTED) return u < v;
+        else return u != v;
+    };
+
+    std::vector<std::uint64_t> offsets(static_cast<std::size_t>(n) + 1, 0);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t ui = begin; ui < end; ++ui) {
+            id_type u = static_cast<id_type>(ui);
+            std::uint64_t count = 0;
+            for (id_type v : g.out_neighbors(u)) if (keep(u, v)) ++count;
+            offsets[ui + 1] = count;
+        }
+    }, 1024);
+    for (id_type u = 0; u < n; ++u) offsets[u + 1] += offsets[u];
+
+    std::vector<WeightedEdge<id_type, W>> edges(offsets[n]);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t ui = begin; ui < end; ++ui) {
+            id_type u = static_cast<id_type>(ui);
+            std::uint64_t pos = offsets[ui];
+            auto prop = g.out_edge_props(u).begin();
+            for (id_type v : g.out_neighbors(u)) {
+                const auto& p = *prop++;
+                if (keep(u, v)) edges[pos++] = {u, v, static_cast<W>(weight(p))};
+            }
+        }
+    }, 1024);
+    return edges;
+}
+
+template<typename CSR, typename WeightFn = IdentityWeight>
+SpanningForest<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>
+boruvka_msf(const CSR& g, WeightFn weight = {}, unsigned threads = hardware_threads()){
+    using id_type = typename CSR::id_type;
+    using W = edge_weight_t<CSR, WeightFn>;
+    const id_type n = g.num_nodes();
+    if (n > static_cast<id_type>(std::numeric_limits<int>::max())) throw std::length_error("boruvka_msf(): 顶点数超出 UnionFind<int> 范围!");
+    if (threads == 0) threads = 1;
+
+    auto all = collect_weighted_edges(g, weight, threads);
+    constexpr std::uint64_t none = std::numeric_limits<std::uint64_t>::max();
+    auto lighter = [&all](std::uint64_t a, std::uint64_t b){
+        return all[a].weight != all[b].weight ? all[a].weight < all[b].weight : a < b;
+    };
+
+    SpanningForest<id_type, W> forest{{}, W(0), n};
+    UnionFind<int> uf(static_cast<int>(n));
+    std::vector<id_type> label(n);
+    for (id_type v = 0; v < n; ++v) label[v] = v;
+    std::vector<std::atomic<std::uint64_t>> best(n);
+    for (auto& b : best) b.store(none, std::memory_order_relaxed);
+
+    // 存活的边(两端不在同一分量)，以 all 中的下标表示
+    std::vector<std::uint64_t> alive(all.size());
+    for (std::uint64_t e = 0; e < all.size(); ++e) alive[e] = e;
+    std::vector<std::vector<std::uint64_t>> local(threads);
+
+    auto offer = [&](id_type c, std::uint64_t e){
+        std::uint64_t cur = best[c].load(std::memory_order_relaxed);
+        while (cur == none || lighter(e, cur)) {
+            if (best[c].compare_exchange_weak(cur, e, std::memory_order_relaxed)) break;
+        }
+    };
+
+    while (!alive.empty()) {
+        // 1. 每个分量的最轻出边
+        parallel_for(alive.size(), threads, [&](std::size_t begin, std::size_t end, unsigned){
+            for (std::size_t i = begin; i < end; ++i) {
+                std::uint64_t e = alive[i];
+                offer(label[all[e].u], e);
+                offer(label[all[e].v], e);
+            }
+        }, 4096);
+
+        // 2. 合并，两个分量选中同一条边时第二次会被 isConnected 挡住
+        bool merged = false;
+        for (id_type c = 0; c < n; ++c) {
+            std::uint64_t e = best[c].load(std::memory_order_relaxed);
+            if (e == none) continue;
+            best[c].store(none, std::memory_order_relaxed);
+            int a = static_cast<int>(all[e].u), b = static_cast<int>(all[e].v);
+            if (uf.isConnected(a, b)) continue;
+            uf.Union(a, b);
+            forest.edges.emplace_back(all[e]);
+            forest.total_weight += all[e].weight;
+            --forest.trees;
+            merged = true;
+        }
+        if (!merged) break;
+        for (id_type v = 0; v < n; ++v) label[v] = static_cast<id_type>(uf.Find(static_cast<int>(v)));
+
+        // 3. 过滤分量内部的边
+        for (auto& l : local) l.clear();
+        parallel_for(alive.size(), threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+            for (std::size_t i = begin; i < end; ++i) {
+                std::uint64_t e = alive[i];
+                if (label[all[e].u] != label[all[e].v]) local[tid].emplace_back(e);
+            }
+        }, 4096);
+        alive.clear();
+        for (auto& l : local) alive.insert(alive.end(), l.begin(), l.end());
+    }
+    return forest;
+}
+
+template<typename CSR, typename WeightFn = IdentityWeight>
+SpanningForest<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>
+filter_kruskal_msf(const CSR& g, WeightFn weight = {}, unsigned threads = hardware_threads()){
+    using id_type = typename CSR::id_type;
+    using W = edge_weight_t<CSR, WeightFn>;
+    using Edge = WeightedEdge<id_type, W>;
+    const id_type n = g.num_nodes();
+    if (n > static_cast<id_type>(std::numeric_limits<int>::max())) throw std::length_error("filter_kruskal_msf(): 顶点数超出 UnionFind<int> 范围!");
+    if (threads == 0) threads = 1;
+
+    auto all = collect_weighted_edges(g, weight, threads);
+    // 以 (权, 原下标) 为全序：把原下标带进排序键
+    std::vector<std::pair<Edge, std::uint64_t>> edges(all.size());
+    for (std::uint64_t e = 0; e < all.size(); ++e) edges[e] = {all[e], e};
+    std::vector<Edge>().swap(all);
+    auto lighter = [](const std::pair<Edge, std::uint64_t>& a, const std::pair<Edge, std::uint64_t>& b){
+        return a.first.weight != b.first.weight ? a.first.weight < b.first.weight : a.second < b.second;
+    };
+
+    SpanningForest<id_type, W> forest{{}, W(0), n};
+    UnionFind<int> uf(static_cast<int>(n));
+    const std::size_t threshold = std::max<std::size_t>(std::size_t(1) << 14, n);
+
+    auto kruskal = [&](auto first, auto last){
+        parallel_sort(first, last, lighter, threads);
+        for (auto it = first; it != last && forest.trees > 1; ++it) {
+            int a = static_cast<int>(it->first.u), b = static_cast<int>(it->first.v);
+            if (uf.isConnected(a, b)) continue;
+            uf.Union(a, b);
+            forest.edges.emplace_back(it->first);
+            forest.total_weight += it->first.weight;
+            --forest.trees;
+        }
+    };
+
+    std::vector<id_type> label(n);
+    auto filter = [&](auto first, auto last){
+        // Find 带路径压缩，不能并发调用：先串行压缩出分量编号，再并行判断
+        for (id_type v = 0; v < n; ++v) label[v] = static_cast<id_type>(uf.Find(static_cast<int>(v)));
+        std::size_t count = static_cast<std::size_t>(last - first);
+        std::vector<char> keep(count);
+        parallel_for(count, threads, [&](std::size_t begin, std::size_t end, unsigned){
+            for (std::size_t i = begin; i < end; ++i) keep[i] = label[first[i].first.u] != label[first[i].first.v];
+        }, 4096);
+        std::size_t out = 0;
+        for (std::size_t i = 0; i < count; ++i) if (keep[i]) first[out++] = std::move(first[i]);
+        return first + out;
+    };
+
+    std::mt19937_64 rng(edges.size());
+    auto recurse = [&](auto& self, auto first, auto last) -> void {
+        std::size_t count = static_cast<std::size_t>(last - first);
+        if (count == 0 || forest.trees <= 1) return;
+        if (count <= threshold) {
+            kruskal(first, last);
+            return;
+        }
+        // 抽样取中位数作枢轴
+        std::vector<std::pair<Edge, std::uint64_t>> sample;
+        std::uniform_int_distribution<std::size_t> pick(0, count - 1);
+        for (int i = 0; i < 63; ++i) sample.emplace_back(first[pick(rng)]);
+        std::nth_element(sample.begin(), sample.begin() + 31, sample.end(), lighter);
+        auto pivot = sample[31];
+        auto mid = std::partition(first, last, [&](const std::pair<Edge, std::uint64_t>& e){return !lighter(pivot, e);});
+        if (mid == first || mid == last) {
+            kruskal(first, last);
+            return;
+        }
+        self(self, first, mid);
+        self(self, mid, filter(mid, last));
+    };
+    recurse(recurse, edges.begin(), edges.end());
+    return forest;
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef PARALLELBFS_HPP
+#define PARALLELBFS_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+
+/**
+ * @file ParallelBFS.hpp
+ * @brief 方向优化(Beamer)的多线程 BFS，运行在 Graph::freeze() 得到的 CSRGraph 上。
+ *
+ * 自顶向下(top-down): 遍历当前层顶点的出边，用 CAS 抢占未访问邻居的 parent，适合前沿较小的层。
+ * 自底向上(bottom-up): 每个未访问顶点扫描自己的入边，只要找到一个在前沿中的父亲就停止，
+ *                     适合前沿覆盖了大部分边的层，能跳过大量冗余的边检查。
+ * 切换条件(alpha, beta 为经验参数):
+ *    - 前沿出度和 m_f > 未探索边数 m_u / alpha 时切到自底向上；
+ *    - 自底向上期间前沿顶点数 n_f < n / beta 且不再增长时切回自顶向下。
+ * 自底向上用位图表示前沿，按 64 位字划分任务，同一个字只由一个线程写，无需原子操作。
+ *
+ * 返回的 parent/distance 以 CSR 的稠密 id 为下标，未到达的顶点为 npos，源点的 parent 是自身。
+ */
+
+template<typename IdType>
+struct BFSResult {
+    IdType source;
+    std::vector<IdType> parent;
+    std::vector<IdType> distance;
+};
+
+template<typename CSR>
+BFSResult<typename CSR::id_type> direction_optimizing_bfs(const CSR& g, typename CSR::id_type source,
+    unsigned threads = hardware_threads(), int alpha = 15, int beta = 18){
+    using id_type = typename CSR::id_type;
+    using offset_type = typename CSR::offset_type;
+    constexpr id_type npos = CSR::npos;
+
+    const id_type n = g.num_nodes();
+    if (source >= n) throw std::out_of_range("direction_optimizing_bfs(): 源点不存在!");
+    if (threads == 0) threads = 1;
+
+    std::vector<std::atomic<id_type>> parent(n);
+    std::vector<id_type> distance(n, npos);
+    for (id_type v = 0; v < n; ++v) parent[v].store(npos, std::memory_order_relaxed);
+    parent[source].store(source, std::memory_order_relaxed);
+    distance[source] = 0;
+
+    const std::size_t words = (static_cast<std::size_t>(n) + 63) / 64;
+    std::vector<std::uint64_t> front_bits, next_bits;
+    std::vector<id_type> queue{source};
+    std::vector<std::vector<id_type>> local_next(threads);
+    std::vector<offset_type> local_scout(threads), local_awake(threads);
+
+    offset_type edges_to_check = g.num_arcs();
+    offset_type scout = g.out_degree(source);
+    id_type depth = 0;
+    bool bottom_up = false;
+
+    // 自顶向下一层，返回新前沿的出度和
+    auto top_down_step = [&](){
+        for (auto& q : local_next) q.clear();
+        std::fill(local_scout.begin(), local_scout.end(), 0);
+        parallel_for(queue.size(), threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+            auto& out = local_next[tid];
+            offset_type sc = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                id_type u = queue[i];
+                for (id_type v : g.out_neighbors(u)) {
+                    id_type expected = npos;
+                    if (parent[v].load(std::memory_order_relaxed) == npos &&
+                        parent[v].compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+                        distance[v] = depth + 1;
+                        out.emplace_back(v);
+                        sc += g.out_degree(v);
+                    }
+                }
+            }
+            local_scout[tid] += sc;
+        }, 64);
+        queue.clear();
+        for (auto& q : local_next) queue.insert(queue.end(), q.begin(), q.end());
+        offset_type total = 0;
+        for (offset_type s : local_scout) total += s;
+        return total;
+    };
+
+    // 自底向上一层，返回新前沿的顶点数
+    auto bottom_up_step = [&](){
+        std::fill(next_bits.begin(), next_bits.end(), 0);
+        std::fill(local_awake.begin(), local_awake.end(), 0);
+        parallel_for(words, threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+            offset_type awake = 0;
+            for (std::size_t w = begin; w < end; ++w) {
+                std::uint64_t bits = 0;
+                id_type last = static_cast<id_type>(std::min<std::size_t>(n, (w + 1) * 64));
+                for (id_type v = static_cast<id_type>(w * 64); v < last; ++v) {
+                    if (parent[v].load(std::memory_order_relaxed) != npos) continue;
+                    for (id_type u : g.in_neighbors(v)) {
+                        if ((front_bits[u >> 6] >> (u & 63)) & 1) {
+                            parent[v].store(u, std::memory_order_relaxed);
+                            distance[v] = depth + 1;
+                            bits |= std::uint64_t(1) << (v & 63);
+                            ++awake;
+                            break;
+                        }
+                    }
+                }
+                next_bits[w] = bits;
+            }
+            local_awake[tid] += awake;
+        }, 16);
+        front_bits.swap(next_bits);
+        offset_type total = 0;
+        for (offset_type a : local_awake) total += a;
+        return total;
+    };
+
+    auto queue_to_bitmap = [&](){
+        front_bits.assign(words, 0);
+        next_bits.assign(words, 0);
+        for (id_type v : queue) front_bits[v >> 6] |= std::uint64_t(1) << (v & 63);
+    };
+
+    auto bitmap_to_queue = [&](){
+        queue.clear();
+        for (std::size_t w = 0; w < words; ++w) {
+            std::uint64_t bits = front_bits[w];
+            while (bits) {
+                int b = lowest_bit_index(bits);
+                queue.emplace_back(static_cast<id_type>(w * 64 + b));
+                bits &= bits - 1;
+            }
+        }
+    };
+
+    while (!queue.empty()) {
+        if (!bottom_up && scout > edges_to_check / static_cast<offset_type>(alpha)) {
+            bottom_up = true;
+            queue_to_bitmap();
+            offset_type awake = queue.size(), old_awake;
+            do {
+                old_awake = awake;
+                awake = bottom_up_step();
+                ++depth;
+            } while (awake != 0 && (awake >= old_awake || awake > n / static_cast<offset_type>(beta)));
+            bitmap_to_queue();
+            bottom_up = false;
+            scout = 0;
+            for (id_type v : queue) scout += g.out_degree(v);
+        } else {
+            edges_to_check = edges_to_check > scout ? edges_to_check - scout : 0;
+            scout = top_down_step();
+            ++depth;
+        }
+    }
+
+    BFSResult<id_type> result{source, std::vector<id_type>(n), std::move(distance)};
+    for (id_type v = 0; v < n; ++v) result.parent[v] = parent[v].load(std::memory_order_relaxed);
+    return result;
+}
+
+#endif
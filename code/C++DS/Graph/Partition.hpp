@@ -0,0 +1,503 @@
+#ifndef PARTITION_HPP
+#define PARTITION_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+#include "Louvain.hpp"
+#include <cmath>
+#include <deque>
+#include <future>
+#include <queue>
+#include <random>
+
+/**
+ * @file Partition.hpp
+ * @brief 多层图划分：把图分成 k 个顶点数均衡的部分并最小化割边权，运行在 CSRGraph / MappedGraph / CompressedGraph 上。
+ *
+ * 1. partition_graph(g, k, options, weight)：k 路划分由递归二分得到，每次二分都是一个完整的多层过程：
+ *    - 粗化：按随机顺序做重边匹配(heavy-edge matching)，每个未匹配顶点与连接权最大的未匹配邻居合并，
+ *      合并后的顶点权不超过上限，保证最粗图上仍能均衡划分；用 louvain_aggregate 收缩成下一层图，
+ *      直到顶点数 <= coarsen_to 或一轮只缩小不到 5%。
+ *    - 初始划分：在最粗图上做贪心生长(greedy graph growing)：从随机种子开始，每次把增益最大的边界顶点
+ *      并入第 0 部分直到达到目标权重；尝试 initial_tries 个种子，取 FM 细化后割最小的一个。
+ *    - 反粗化：逐层把划分投影回细图，每层做 Fiduccia-Mattheyses 细化：两侧各一个按增益排序的懒删除堆，
+ *      每次移动不破坏均衡且增益最大的未锁定顶点(允许负增益以跳出局部最优)，记下整轮中割最小的前缀，
+ *      其后的移动全部回滚；连续若干步没有改进即提前结束本轮。
+ *    两个子问题互不相关，threads > 1 时递归的左右两支并行执行。
+ *
+ * 2. make_shards(g, result)：按划分结果为每个部分构造一个可修改的 Graph(默认类型见 partition_subgraph_t)，
+ *    包含本部分的顶点、与本部分相邻的幽灵(ghost)顶点，以及至少有一个端点属于本部分的全部边(连同属性)；
+ *    boundary 为有邻居在其他部分的本部分顶点，ghosts / ghost_owner 给出幽灵顶点及其所属部分。
+ *    各部分的子图由多个线程并行构造。
+ *
+ * 边权来自边属性，EdgePropType 为 void 时每条边权为 1；有向图按底图处理。每个顶点的权为 1，
+ * 各部分的顶点数不超过 (1 + imbalance) * n / k(向上取整)；递归二分的每一层分摊这一容差。
+ */
+
+struct PartitionOptions {
+    double imbalance = 0.03;          // 各部分允许超出目标大小的比例
+    std::uint32_t coarsen_to = 128;   // 粗化停止的顶点数
+    std::size_t initial_tries = 4;    // 初始划分尝试的种子数
+    std::size_t fm_passes = 8;        // 每层 FM 细化的最多轮数
+    std::uint64_t seed = 1;
+    unsigned threads = hardware_threads();
+};
+
+struct PartitionResult {
+    std::vector<std::uint32_t> part;          // 以 CSR 的稠密 id 为下标，取值 [0, parts)
+    std::uint32_t parts;
+    double edge_cut;                          // 跨部分的边权之和
+    std::vector<std::uint64_t> part_sizes;
+};
+
+// 多层二分中的一层：带顶点权的图，最细一层指向调用方的图
+struct BisectionLevel {
+    const LouvainGraph* graph;
+    std::vector<std::int64_t> vwgt;
+    std::vector<std::uint32_t> to_coarse;     // 本层顶点 -> 下一层(更粗)顶点
+};
+
+// 重边匹配：返回压缩后的粗顶点编号与粗顶点数
+inline std::uint32_t partition_match(const LouvainGraph& g, const std::vector<std::int64_t>& vwgt, std::int64_t max_vwgt,
+    std::mt19937_64& rng, std::vector<std::uint32_t>& labels){
+    const std::uint32_t n = g.num_nodes();
+    constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0u);
+    std::shuffle(order.begin(), order.end(), rng);
+    labels.assign(n, none);
+    std::uint32_t count = 0;
+    for (std::uint32_t u : order) {
+        if (labels[u] != none) continue;
+        std::uint32_t best = none;
+        double best_w = 0;
+        for (std::uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            std::uint32_t v = g.targets[e];
+            if (labels[v] != none || vwgt[u] + vwgt[v] > max_vwgt) continue;
+            if (best == none || g.weights[e] > best_w) {
+                best = v;
+                best_w = g.weights[e];
+            }
+        }
+        labels[u] = count;
+        if (best != none) labels[best] = count;
+        ++count;
+    }
+    return count;
+}
+
+// 两侧的懒删除最大堆：(增益, 顶点)，与 gain[v] 不符或已锁定即为陈旧项
+using PartitionHeap = std::priority_queue<std::pair<double, std::uint32_t>>;
+
+// FM 细化二分 side，返回最终割
+inline double partition_fm(const LouvainGraph& g, const std::vector<std::int64_t>& vwgt, std::vector<std::uint8_t>& side,
+    const std::int64_t max_weight[2], std::size_t passes){
+    const std::uint32_t n = g.num_nodes();
+    std::vector<double> gain(n);
+    std::vector<char> locked(n);
+    std::vector<std::uint32_t> moves;
+    std::int64_t weight[2] = {0, 0};
+    for (std::uint32_t v = 0; v < n; ++v) weight[side[v]] += vwgt[v];
+    auto violation = [&](){
+        return std::max<std::int64_t>(0, weight[0] - max_weight[0]) + std::max<std::int64_t>(0, weight[1] - max_weight[1]);
+    };
+
+    double cut = 0;
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+        PartitionHeap heap[2];
+        cut = 0;
+        for (std::uint32_t v = 0; v < n; ++v) {
+            double ext = 0, in = 0;
+            for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                (side[g.targets[e]] == side[v] ? in : ext) += g.weights[e];
+            }
+            gain[v] = ext - in;
+            cut += ext;
+            locked[v] = 0;
+        }
+        cut /= 2;
+        for (std::uint32_t v = 0; v < n; ++v) {
+            // 边界顶点参与移动；某侧超重时该侧全部顶点都是候选
+            bool boundary = false;
+            for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1] && !boundary; ++e) boundary = side[g.targets[e]] != side[v];
+            if (boundary || weight[side[v]] > max_weight[side[v]]) heap[side[v]].emplace(gain[v], v);
+        }
+
+        moves.clear();
+        const double start_cut = cut;
+        const std::int64_t start_violation = violation();
+        double best_cut = cut;
+        std::int64_t best_violation = start_violation;
+        std::size_t best_moves = 0;
+        const std::size_t patience = std::max<std::size_t>(50, n / 100);
+
+        auto top = [&](int s) -> std::uint32_t {
+            while (!heap[s].empty()) {
+                auto [gv, v] = heap[s].top();
+                if (!locked[v] && side[v] == s && gv == gain[v]) return v;
+                heap[s].pop();
+            }
+            return std::numeric_limits<std::uint32_t>::max();
+        };
+
+        // 超重的一侧必须移出；否则取两侧中增益较大、且移动后对侧不超重的堆顶
+        auto select = [&](int& from) -> std::uint32_t {
+            constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+            while (true) {
+                std::uint32_t c[2] = {top(0), top(1)};
+                int forced = weight[0] > max_weight[0] ? 0 : weight[1] > max_weight[1] ? 1 : -1;
+                if (forced >= 0) {
+                    from = forced;
+                    return c[forced];
+                }
+                bool ok[2];
+                for (int s = 0; s < 2; ++s) ok[s] = c[s] != none && weight[1 - s] + vwgt[c[s]] <= max_weight[1 - s];
+                if (ok[0] && (!ok[1] || gain[c[0]] >= gain[c[1]])) {
+                    from = 0;
+                    return c[0];
+                }
+                if (ok[1]) {
+                    from = 1;
+                    return c[1];
+                }
+                if (c[0] == none && c[1] == none) return none;
+                // 两个堆顶移动后都会使对侧超重：本轮暂不考虑，增益变化时会重新入堆
+                for (int s = 0; s < 2; ++s) if (c[s] != none) heap[s].pop();
+            }
+        };
+
+        while (moves.size() - best_moves <= patience) {
+            int from = 0;
+            std::uint32_t v = select(from);
+            if (v == std::numeric_limits<std::uint32_t>::max()) break;
+
+            heap[from].pop();
+            locked[v] = 1;
+            side[v] = static_cast<std::uint8_t>(1 - from);
+            weight[from] -= vwgt[v];
+            weight[1 - from] += vwgt[v];
+            cut -= gain[v];
+            gain[v] = -gain[v];
+            moves.emplace_back(v);
+            for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                std::uint32_t x = g.targets[e];
+                if (locked[x]) continue;
+                // v 与 x 同侧后 x 的外部权减少、内部权增加，反之亦然
+                gain[x] += side[x] == side[v] ? -2 * g.weights[e] : 2 * g.weights[e];
+                heap[side[x]].emplace(gain[x], x);
+            }
+
+            std::int64_t viol = violation();
+            if (viol < best_violation || (viol == best_violation && cut < best_cut - 1e-12)) {
+                best_violation = viol;
+                best_cut = cut;
+                best_moves = moves.size();
+            }
+        }
+
+        // 回滚最优前缀之后的移动
+        while (moves.size() > best_moves) {
+            std::uint32_t v = moves.back();
+            moves.pop_back();
+            int to = side[v];
+            side[v] = static_cast<std::uint8_t>(1 - to);
+            weight[to] -= vwgt[v];
+            weight[1 - to] += vwgt[v];
+        }
+        cut = best_cut;
+        if (best_moves == 0 || (best_violation == start_violation && best_cut >= start_cut - 1e-12)) break;
+    }
+    return cut;
+}
+
+// 贪心生长：从 seed 出发按增益把顶点并入第 0 部分，直到其权重达到 target0
+inline void partition_grow(const LouvainGraph& g, const std::vector<std::int64_t>& vwgt, std::int64_t target0,
+    std::uint32_t seed, std::mt19937_64& rng, std::vector<std::uint8_t>& side){
+    const std::uint32_t n = g.num_nodes();
+    side.assign(n, 1);
+    std::vector<double> gain(n);
+    for (std::uint32_t v = 0; v < n; ++v) {
+        double d = 0;
+        for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) d += g.weights[e];
+        gain[v] = -d;
+    }
+    PartitionHeap heap;
+    heap.emplace(gain[seed], seed);
+    std::int64_t weight0 = 0;
+    std::vector<std::uint32_t> rest(n);
+    std::iota(rest.begin(), rest.end(), 0u);
+    std::shuffle(rest.begin(), rest.end(), rng);
+    std::size_t next_rest = 0;
+    while (weight0 < target0) {
+        std::uint32_t v = std::numeric_limits<std::uint32_t>::max();
+        while (!heap.empty()) {
+            auto [gv, u] = heap.top();
+            heap.pop();
+            if (side[u] == 1 && gv == gain[u]) {
+                v = u;
+                break;
+            }
+        }
+        if (v == std::numeric_limits<std::uint32_t>::max()) {
+            // 当前连通块已用完，从其他块中随机取一个顶点
+            while (next_rest < n && side[rest[next_rest]] == 0) ++next_rest;
+            if (next_rest == n) break;
+            v = rest[next_rest];
+        }
+        side[v] = 0;
+        weight0 += vwgt[v];
+        for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+            std::uint32_t x = g.targets[e];
+            if (side[x] == 0) continue;
+            gain[x] += 2 * g.weights[e];
+            heap.emplace(gain[x], x);
+        }
+    }
+}
+
+// 多层二分：第 0 部分的目标权重为 total * fraction，返回每个顶点所在的一侧
+inline std::vector<std::uint8_t> partition_bisect(const LouvainGraph& graph, std::vector<std::int64_t> vwgt, double fraction,
+    double imbalance, const PartitionOptions& options, std::uint64_t seed, unsigned threads){
+    std::mt19937_64 rng(seed);
+    std::deque<LouvainGraph> coarse_graphs; // deque 追加时不移动已有元素，levels 中的指针保持有效
+    std::vector<BisectionLevel> levels;
+    levels.push_back({&graph, std::move(vwgt), {}});
+
+    std::int64_t total = 0;
+    for (auto w : levels[0].vwgt) total += w;
+    const std::int64_t target0 = static_cast<std::int64_t>(std::llround(static_cast<double>(total) * fraction));
+    const std::int64_t targets[2] = {target0, total - target0};
+    const std::uint32_t coarsen_to = std::max<std::uint32_t>(options.coarsen_to, 2);
+    const std::int64_t max_vwgt = std::max<std::int64_t>(1, static_cast<std::int64_t>(1.5 * static_cast<double>(total) / coarsen_to));
+
+    // 粗化
+    while (levels.back().graph->num_nodes() > coarsen_to) {
+        auto& fine = levels.back();
+        const std::uint32_t fn = fine.graph->num_nodes();
+        std::vector<std::uint32_t> labels;
+        std::uint32_t count = partition_match(*fine.graph, fine.vwgt, max_vwgt, rng, labels);
+        if (count > fn - fn / 20) break;
+        coarse_graphs.push_back(louvain_aggregate(*fine.graph, labels, count, threads));
+        std::vector<std::int64_t> coarse_vwgt(count, 0);
+        for (std::uint32_t v = 0; v < fn; ++v) coarse_vwgt[labels[v]] += fine.vwgt[v];
+        fine.to_coarse = std::move(labels);
+        levels.push_back({&coarse_graphs.back(), std::move(coarse_vwgt), {}});
+    }
+
+    // 本层的均衡上限：粗层的顶点较重，额外放宽一个最重顶点的权
+    auto bounds = [&](const BisectionLevel& level, std::int64_t out[2]){
+        std::int64_t heaviest = 1;
+        for (auto w : level.vwgt) heaviest = std::max(heaviest, w);
+        for (int s = 0; s < 2; ++s) {
+            out[s] = static_cast<std::int64_t>(std::ceil(static_cast<double>(targets[s]) * (1 + imbalance))) + heaviest - 1;
+        }
+    };
+
+    // 初始划分
+    const auto& coarsest = levels.back();
+    const std::uint32_t cn = coarsest.graph->num_nodes();
+    std::vector<std::uint8_t> side(cn, 1);
+    if (cn > 0) {
+        std::int64_t max_weight[2];
+        bounds(coarsest, max_weight);
+        double best_cut = std::numeric_limits<double>::max();
+        std::int64_t best_violation = std::numeric_limits<std::int64_t>::max();
+        std::vector<std::uint8_t> trial;
+        for (std::size_t t = 0; t < std::max<std::size_t>(options.initial_tries, 1); ++t) {
+            partition_grow(*coarsest.graph, coarsest.vwgt, targets[0], static_cast<std::uint32_t>(rng() % cn), rng, trial);
+            double cut = partition_fm(*coarsest.graph, coarsest.vwgt, trial, max_weight, options.fm_passes);
+            std::int64_t weight0 = 0;
+            for (std::uint32_t v = 0; v < cn; ++v) if (trial[v] == 0) weight0 += coarsest.vwgt[v];
+            std::int64_t viol = std::max<std::int64_t>(0, weight0 - max_weight[0]) + std::max<std::int64_t>(0, total - weight0 - max_weight[1]);
+            if (viol < best_violation || (viol == best_violation && cut < best_cut)) {
+                best_violation = viol;
+                best_cut = cut;
+                side = trial;
+            }
+        }
+    }
+
+    // 反粗化
+    for (std::size_t lv = levels.size() - 1; lv-- > 0; ) {
+        const auto& fine = levels[lv];
+        std::vector<std::uint8_t> projected(fine.graph->num_nodes());
+        for (std::uint32_t v = 0; v < fine.graph->num_nodes(); ++v) projected[v] = side[fine.to_coarse[v]];
+        side = std::move(projected);
+        std::int64_t max_weight[2];
+        bounds(fine, max_weight);
+        partition_fm(*fine.graph, fine.vwgt, side, max_weight, options.fm_passes);
+    }
+    return side;
+}
+
+// g 中 side[v] == which 的顶点的导出子图，local 记录 g 中顶点在子图中的编号
+inline LouvainGraph partition_induced(const LouvainGraph& g, const std::vector<std::uint8_t>& side, std::uint8_t which,
+    const std::vector<std::uint32_t>& local){
+    LouvainGraph h;
+    for (std::uint32_t v = 0; v < g.num_nodes(); ++v) {
+        if (side[v] != which) continue;
+        for (std::uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+            std::uint32_t x = g.targets[e];
+            if (side[x] != which) continue;
+            h.targets.emplace_back(local[x]);
+            h.weights.emplace_back(g.weights[e]);
+        }
+        h.offsets.emplace_back(h.targets.size());
+        h.loops.emplace_back(0.0);
+    }
+    h.finish(1);
+    return h;
+}
+
+// 把 g 递归二分成 parts 个部分，编号从 first 开始；ids[v] 为 g 中顶点在原图中的 id
+inline void partition_recurse(const LouvainGraph& g, const std::vector<std::uint32_t>& ids, std::uint32_t first, std::uint32_t parts,
+    double imbalance, const PartitionOptions& options, unsigned threads, std::vector<std::uint32_t>& part){
+    const std::uint32_t n = g.num_nodes();
+    if (parts == 1 || n == 0) {
+        for (std::uint32_t id : ids) part[id] = first;
+        return;
+    }
+    const std::uint32_t left_parts = parts / 2;
+    std::vector<std::uint8_t> side = partition_bisect(g, std::vector<std::int64_t>(n, 1), static_cast<double>(left_parts) / parts,
+        imbalance, options, options.seed * 0x9E3779B97F4A7C15ull + first * 0x100000001B3ull + parts, threads);
+
+    // 子问题只持有自己那一半的导出子图，递归的总内存为 O((n + m) log k)
+    std::vector<std::uint32_t> local(n), child_ids[2];
+    for (std::uint32_t v = 0; v < n; ++v) {
+        local[v] = static_cast<std::uint32_t>(child_ids[side[v]].size());
+        child_ids[side[v]].emplace_back(ids[v]);
+    }
+    LouvainGraph left = partition_induced(g, side, 0, local);
+    LouvainGraph right = partition_induced(g, side, 1, local);
+
+    if (threads > 1) {
+        unsigned left_threads = threads / 2;
+        auto task = std::async(std::launch::async, [&]{
+            partition_recurse(left, child_ids[0], first, left_parts, imbalance, options, left_threads, part);
+        });
+        partition_recurse(right, child_ids[1], first + left_parts, parts - left_parts, imbalance, options, threads - left_threads, part);
+        task.get();
+    } else {
+        partition_recurse(left, child_ids[0], first, left_parts, imbalance, options, 1, part);
+        partition_recurse(right, child_ids[1], first + left_parts, parts - left_parts, imbalance, options, 1, part);
+    }
+}
+
+template<typename CSR, typename WeightFn = IdentityWeight>
+PartitionResult partition_graph(const CSR& g, std::uint32_t parts, const PartitionOptions& options = {}, WeightFn weight = {}){
+    using id_type = typename CSR::id_type;
+    if (parts == 0) throw std::invalid_argument("partition_graph(): 部分数必须为正!");
+    if (!(options.imbalance >= 0)) throw std::invalid_argument("partition_graph(): imbalance 不能为负!");
+    const unsigned threads = options.threads == 0 ? 1 : options.threads;
+    const id_type n = g.num_nodes();
+
+    PartitionResult result{std::vector<std::uint32_t>(n, 0), parts, 0.0, std::vector<std::uint64_t>(parts, 0)};
+    if (n == 0) return result;
+    LouvainGraph lg = louvain_graph_from(g, weight, threads);
+
+    // 每层二分分摊总容差：(1 + eps)^depth = 1 + imbalance
+    double depth = std::ceil(std::log2(static_cast<double>(parts)));
+    double imbalance = depth > 0 ? std::pow(1 + options.imbalance, 1 / depth) - 1 : options.imbalance;
+    std::vector<std::uint32_t> ids(n);
+    std::iota(ids.begin(), ids.end(), 0u);
+    partition_recurse(lg, ids, 0, parts, imbalance, options, threads, result.part);
+
+    for (id_type v = 0; v < n; ++v) {
+        ++result.part_sizes[result.part[v]];
+        for (std::uint64_t e = lg.offsets[v]; e < lg.offsets[v + 1]; ++e) {
+            if (result.part[lg.targets[e]] != result.part[v]) result.edge_cut += lg.weights[e];
+        }
+    }
+    result.edge_cut /= 2;
+    return result;
+}
+
+// 各部分子图的默认类型：顶点、属性、方向与原图一致，允许自环，原图中的重复边只保留一条
+template<typename CSR>
+using partition_subgraph_t = Graph<typename CSR::node_type, typename CSR::node_prop_type, typename CSR::edge_prop_type,
+    CSR::direction, MultiEdge::DISALLOWED, SelfLoop::ALLOWED>;
+
+template<typename NodeType, typename SubGraph>
+struct Shard {
+    SubGraph graph;                             // 本部分顶点 + 幽灵顶点，以及至少一端属于本部分的边
+    std::vector<NodeType> owned;
+    std::vector<NodeType> boundary;             // 有邻居在其他部分的本部分顶点
+    std::vector<NodeType> ghosts;               // 其他部分中与本部分相邻的顶点
+    std::vector<std::uint32_t> ghost_owner;     // ghosts[i] 所属的部分
+};
+
+template<typename SubGraph = void, typename CSR>
+auto make_shards(const CSR& g, const PartitionResult& partition, unsigned threads = hardware_threads()){
+    using id_type = typename CSR::id_type;
+    using NodeType = typename CSR::node_type;
+    using Sub = std::conditional_t<std::is_void_v<SubGraph>, partition_subgraph_t<CSR>, SubGraph>;
+    using EdgeProp = typename CSR::edge_prop_type;
+    constexpr bool with_prop = !std::is_void_v<EdgeProp>;
+    using Arc = std::conditional_t<with_prop, std::tuple<NodeType, NodeType, std::conditional_t<with_prop, EdgeProp, char>>,
+        std::pair<NodeType, NodeType>>;
+
+    const id_type n = g.num_nodes();
+    if (partition.part.size() != n) throw std::invalid_argument("make_shards(): 划分结果与图的顶点数不一致!");
+    const std::uint32_t k = partition.parts;
+    const auto& part = partition.part;
+
+    std::vector<Shard<NodeType, Sub>> shards(k);
+    std::vector<std::vector<Arc>> arcs(k);
+    std::vector<std::vector<id_type>> owned_ids(k), ghost_ids(k);
+    std::vector<char> is_boundary(n, 0);
+
+    // 一条边归入两端所在的部分，跨部分的边同时登记边界顶点与幽灵顶点
+    auto visit = [&](id_type u, id_type v, const auto*... prop){
+        // 无向图的每条边在两端各出现一次，只处理 u <= v 的一次
+        if (CSR::direction == EdgeDirection::UNDIRECTED && v < u) return;
+        auto add = [&](std::uint32_t p){arcs[p].emplace_back(g.node_of(u), g.node_of(v), *prop...);};
+        add(part[u]);
+        if (part[v] != part[u]) {
+            add(part[v]);
+            is_boundary[u] = is_boundary[v] = 1;
+            ghost_ids[part[u]].emplace_back(v);
+            ghost_ids[part[v]].emplace_back(u);
+        }
+    };
+    for (id_type u = 0; u < n; ++u) {
+        owned_ids[part[u]].emplace_back(u);
+        if constexpr (with_prop) {
+            auto prop = g.out_edge_props(u).begin();
+            for (id_type v : g.out_neighbors(u)) {
+                const auto& p = *prop++;
+                visit(u, v, &p);
+            }
+        } else {
+            for (id_type v : g.out_neighbors(u)) visit(u, v);
+        }
+    }
+
+    parallel_for(k, threads == 0 ? 1 : threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t p = begin; p < end; ++p) {
+            auto& shard = shards[p];
+            auto& ghosts = ghost_ids[p];
+            std::sort(ghosts.begin(), ghosts.end());
+            ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+            auto add_node = [&](id_type v){
+                if constexpr (std::is_void_v<typename CSR::node_prop_type>) shard.graph.add_node(g.node_of(v));
+                else shard.graph.add_node_with_prop(g.node_of(v), g.node_prop(v));
+            };
+            for (id_type v : owned_ids[p]) {
+                shard.owned.emplace_back(g.node_of(v));
+                if (is_boundary[v]) shard.boundary.emplace_back(g.node_of(v));
+                add_node(v);
+            }
+            for (id_type v : ghosts) {
+                shard.ghosts.emplace_back(g.node_of(v));
+                shard.ghost_owner.emplace_back(part[v]);
+                add_node(v);
+            }
+            if constexpr (with_prop) shard.graph.add_edges_with_prop(arcs[p].begin(), arcs[p].end());
+            else shard.graph.add_edges(arcs[p].begin(), arcs[p].end());
+            arcs[p] = {};
+        }
+    }, 1);
+    return shards;
+}
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef POINTTOPOINT_HPP
+#define POINTTOPOINT_HPP
+
+#include "Graph.hpp"
+#include "ShortestPath.hpp"
+#include "../Tree/IndexedPriorityQueue.hpp"
+
+/**
+ * @file PointToPoint.hpp
+ * @brief 点对点最短路：双向 Dijkstra 与 A*，运行在 CSRGraph / MappedGraph / CompressedGraph 上。
+ *
+ * 1. bidirectional_dijkstra(g, s, t, weight, workspace):
+ *    - 从 s 沿出边、从 t 沿入边同时搜索，每次扩展堆中元素较少(前沿较小)的一侧，使两侧的搜索量保持平衡；
+ *    - 松弛时若对侧已到达该顶点，用 d_f(u) + w + d_b(v) 更新当前最优 mu；
+ *    - 两侧堆顶之和 >= mu 时停止，通常只访问以 s、t 为圆心、半径约为一半距离的两个"球"。
+ *
+ * 2. astar(g, s, t, heuristic, weight, workspace):
+ *    - heuristic(node_prop(v), node_prop(t)) 给出 v 到 t 的距离下界(例如坐标间的直线距离)，堆键为 d(v) + h(v)；
+ *    - 启发函数一致(满足三角不等式)时每个顶点只出堆一次；只可采纳不一致时，距离变小的已出堆顶点会重新入堆，结果仍然正确。
+ *
+ * SearchWorkspace 保存距离、前驱与 IndexedPriorityQueue，数组按时间戳(epoch)判定有效性：
+ * 每次查询只把 epoch 加一，不需要 O(n) 的重新初始化，IndexedPriorityQueue::clear() 也只重置上次留在堆中的下标。
+ * 不传 workspace 时使用当前线程的 thread_local 工作区，多个线程可以同时对同一个只读图发起查询。
+ */
+
+template<typename IdType, typename W>
+struct PathResult {
+    W distance;               // 不可达为 std::numeric_limits<W>::max()
+    std::vector<IdType> path; // s ... t，不可达为空
+    std::size_t settled;      // 出堆的顶点数，衡量搜索空间
+
+    bool found() const {return !path.empty();}
+};
+
+template<typename IdType, typename W>
+class SearchWorkspace {
+public:
+    static constexpr W inf = std::numeric_limits<W>::max();
+    static constexpr IdType npos = std::numeric_limits<IdType>::max();
+
+    // 单向搜索的状态
+    struct Side {
+        std::vector<W> dist;
+        std::vector<IdType> parent;
+        std::vector<std::uint32_t> reached; // == epoch 时 dist/parent 有效
+        std::vector<std::uint32_t> settled; // == epoch 时已出堆
+        IndexedPriorityQueue<W> heap;
+    };
+
+private:
+    Side sides[2];
+    std::uint32_t epoch = 0;
+
+public:
+    // 为 n 个顶点的图开始一次新查询
+    void prepare(std::size_t n){
+        for (auto& side : sides) {
+            side.heap.clear();
+            if (side.dist.size() != n) {
+                side.dist.assign(n, inf);
+                side.parent.assign(n, npos);
+                side.reached.assign(n, 0);
+                side.settled.assign(n, 0);
+                side.heap.resize(n);
+            }
+        }
+        if (++epoch == 0) { // 时间戳回绕：真正清零一次
+            for (auto& side : sides) {
+                std::fill(side.reached.begin(), side.reached.end(), 0);
+                std::fill(side.settled.begin(), side.settled.end(), 0);
+            }
+            epoch = 1;
+        }
+    }
+
+    Side& forward() noexcept {return sides[0];}
+    Side& backward() noexcept {return sides[1];}
+
+    W distance(const Side& side, IdType v) const {return side.reached[v] == epoch ? side.dist[v] : inf;}
+    bool is_settled(const Side& side, IdType v) const {return side.settled[v] == epoch;}
+    void settle(Side& side, IdType v) {side.settled[v] = epoch;}
+    void unsettle(Side& side, IdType v) {side.settled[v] = 0;}
+    void reach(Side& side, IdType v, W d, IdType parent){
+        side.reached[v] = epoch;
+        side.dist[v] = d;
+        side.parent[v] = parent;
+    }
+};
+
+// 当前线程的工作区，同一线程内的查询复用同一块内存
+template<typename IdType, typename W>
+SearchWorkspace<IdType, W>& thread_workspace(){
+    thread_local SearchWorkspace<IdType, W> workspace;
+    return workspace;
+}
+
+template<typename CSR, typename WeightFn = IdentityWeight>
+PathResult<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>
+bidirectional_dijkstra(const CSR& g, typename CSR::id_type s, typename CSR::id_type t, WeightFn weight = {},
+    SearchWorkspace<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>* workspace = nullptr){
+    using id_type = typename CSR::id_type;
+    using W = edge_weight_t<CSR, WeightFn>;
+    using Workspace = SearchWorkspace<id_type, W>;
+    static_assert(std::is_arithmetic_v<W>, "边权必须是数值类型!");
+    constexpr W inf = Workspace::inf;
+
+    const id_type n = g.num_nodes();
+    if (s >= n || t >= n) throw std::out_of_range("bidirectional_dijkstra(): 源点或终点不存在!");
+    Workspace& ws = workspace ? *workspace : thread_workspace<id_type, W>();
+    ws.prepare(n);
+    auto& fw = ws.forward();
+    auto& bw = ws.backward();
+
+    PathResult<id_type, W> result{inf, {}, 0};
+    ws.reach(fw, s, 0, s);
+    ws.reach(bw, t, 0, t);
+    fw.heap.push(s, 0);
+    bw.heap.push(t, 0);
+    W mu = s == t ? W(0) : inf;
+    id_type meet = s == t ? s : CSR::npos;
+
+    // 扩展一侧的堆顶，reverse 表示沿入边
+    auto step = [&](auto& self, auto& other, bool reverse){
+        id_type u = static_cast<id_type>(self.heap.getTopIndex());
+        W du = self.heap.getTopKey();
+        self.heap.pop();
+        ws.settle(self, u);
+        ++result.settled;
+        auto relax = [&](id_type v, W w){
+            if (w < W(0)) throw std::invalid_argument("bidirectional_dijkstra(): 存在负权边!");
+            if (ws.is_settled(self, v)) return;
+            W nd = du + w;
+            if (nd < ws.distance(self, v)) {
+                ws.reach(self, v, nd, u);
+                self.heap.pushOrDecrease(v, nd);
+            }
+            W dv = ws.distance(other, v);
+            if (dv != inf && nd + dv < mu) {
+                mu = nd + dv;
+                meet = v;
+            }
+        };
+        if (reverse) {
+            auto prop = g.in_edge_props(u).begin();
+            for (id_type v : g.in_neighbors(u)) relax(v, weight(*prop++));
+        } else {
+            auto prop = g.out_edge_props(u).begin();
+            for (id_type v : g.out_neighbors(u)) relax(v, weight(*prop++));
+        }
+    };
+
+    while (!fw.heap.isEmpty() && !bw.heap.isEmpty()) {
+        W top_f = fw.heap.getTopKey(), top_b = bw.heap.getTopKey();
+        if (mu != inf && top_f + top_b >= mu) break;
+        if (fw.heap.getSize() <= bw.heap.getSize()) step(fw, bw, false);
+        else step(bw, fw, true);
+    }
+
+    if (meet == CSR::npos) return result;
+    result.distance = mu;
+    for (id_type v = meet; ; v = fw.parent[v]) {
+        result.path.emplace_back(v);
+        if (v == s) break;
+    }
+    std::reverse(result.path.begin(), result.path.end());
+    for (id_type v = meet; v != t; ) {
+        v = bw.parent[v];
+        result.path.emplace_back(v);
+    }
+    return result;
+}
+
+template<typename CSR, typename Heuristic, typename WeightFn = IdentityWeight>
+PathResult<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>
+astar(const CSR& g, typename CSR::id_type s, typename CSR::id_type t, Heuristic heuristic, WeightFn weight = {},
+    SearchWorkspace<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>* workspace = nullptr){
+    using id_type = typename CSR::id_type;
+    using W = edge_weight_t<CSR, WeightFn>;
+    using Workspace = SearchWorkspace<id_type, W>;
+    static_assert(std::is_arithmetic_v<W>, "边权必须是数值类型!");
+    static_assert(!std::is_void_v<typename CSR::node_prop_type>, "A* 的启发函数作用在顶点属性上，此图不存在顶点属性!");
+
+    const id_type n = g.num_nodes();
+    if (s >= n || t >= n) throw std::out_of_range("astar(): 源点或终点不存在!");
+    Workspace& ws = workspace ? *workspace : thread_workspace<id_type, W>();
+    ws.prepare(n);
+    auto& side = ws.forward();
+    const auto& goal = g.node_prop(t);
+    auto h = [&](id_type v){return static_cast<W>(heuristic(g.node_prop(v), goal));};
+
+    PathResult<id_type, W> result{Workspace::inf, {}, 0};
+    ws.reach(side, s, 0, s);
+    side.heap.push(s, h(s));
+    while (!side.heap.isEmpty()) {
+        id_type u = static_cast<id_type>(side.heap.getTopIndex());
+        side.heap.pop();
+        ws.settle(side, u);
+        ++result.settled;
+        if (u == t) break;
+        W du = ws.distance(side, u);
+        auto prop = g.out_edge_props(u).begin();
+        for (id_type v : g.out_neighbors(u)) {
+            W w = weight(*prop++);
+            if (w < W(0)) throw std::invalid_argument("astar(): 存在负权边!");
+            W nd = du + w;
+            if (nd < ws.distance(side, v)) {
+                ws.reach(side, v, nd, u);
+                ws.unsettle(side, v); // 启发函数不一致时允许重新打开
+                side.heap.pushOrDecrease(v, nd + h(v));
+            }
+        }
+    }
+
+    if (!ws.is_settled(side, t)) return result;
+    result.distance = ws.distance(side, t);
+    for (id_type v = t; ; v = side.parent[v]) {
+        result.path.emplace_back(v);
+        if (v == s) break;
+    }
+    std::reverse(result.path.begin(), result.path.end());
+    return result;
+}
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef PROPERTYCOLUMNS_HPP
+#define PROPERTYCOLUMNS_HPP
+
+#include "Graph.hpp"
+
+/**
+ * @file PropertyColumns.hpp
+ * @brief 列式(struct-of-arrays)顶点/边属性存储，以稠密顶点 id / 边偏移为下标。
+ *
+ * Graph 的 NodePropStorageSelector / EdgePropStorageSelector 把属性放在以顶点或 std::pair 为键的哈希表里，
+ * 每次访问都要哈希；CSRGraph 虽然按 id / 偏移连续存放，但仍是整个结构体一个挨一个(array-of-structs)，
+ * 只读一个字段的分析也要把整个结构体带进缓存。PropertyColumns 把聚合类型的每个字段拆成独立的一列：
+ *
+ *    struct Road {double length; int lanes; std::string name;};
+ *    auto cols = edge_columns<&Road::length, &Road::lanes>(g);   // 只抽取需要的字段
+ *    const auto& len = cols.column<&Road::length>();             // std::vector<double>，按边偏移顺序
+ *
+ * 1. PropertyColumns<Prop, &Prop::a, &Prop::b, ...>：
+ *    - 每个成员指针对应一列 std::vector<成员类型>，column<&Prop::a>() 或 column<I>() 取得整列；
+ *    - at<&Prop::a>(i) 访问单个元素，row(i) 把各列重新拼成一个 Prop(未列出的字段取默认值)，
+ *      assign(i, prop) / push_back(prop) 按字段分散写入；
+ *    - 不给成员指针时只有一列 Prop 本身，等价于一个 std::vector<Prop>，用于非聚合的属性类型；
+ *    - bool 字段存为 std::uint8_t，避免 std::vector<bool> 的位代理，列仍可取引用、按字节顺序扫描。
+ *
+ * 2. node_columns<...>(g) / edge_columns<...>(g)：从 CSRGraph / MappedGraph / CompressedGraph 抽取，
+ *    顶点列以稠密 id 为下标，边列以出边偏移为下标(即 u 的第 j 个出邻居对应 offsets()[u] + j，
+ *    与 CSRGraph::edge_index 一致；无向边的两个方向各占一个偏移)。抽取按行分块并行，各列写入互不重叠的区间。
+ *
+ * 各列长度始终相同；列存储只是原图属性的一份拷贝，修改它不会影响原图。
+ */
+
+template<typename M>
+struct member_pointer_traits;
+
+template<typename C, typename T>
+struct member_pointer_traits<T C::*> {
+    using class_type = C;
+    using value_type = T;
+};
+
+// 列中实际保存的类型：bool 改存 std::uint8_t
+template<typename T>
+using column_value_t = std::conditional_t<std::is_same_v<T, bool>, std::uint8_t, T>;
+
+template<typename Prop, auto... Members>
+class PropertyColumns {
+    static_assert((std::is_same_v<typename member_pointer_traits<decltype(Members)>::class_type, Prop> && ...),
+        "成员指针必须指向 Prop 的数据成员!");
+
+    static constexpr bool whole = sizeof...(Members) == 0; // 不拆字段，整体作为一列
+
+    using Columns = std::conditional_t<whole, std::tuple<std::vector<Prop>>,
+        std::tuple<std::vector<column_value_t<typename member_pointer_traits<decltype(Members)>::value_type>>...>>;
+    Columns columns;
+
+    template<auto A, auto B>
+    static constexpr bool same_member(){
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>) return A == B;
+        else return false;
+    }
+
+    // 成员指针在参数包中的位置，不存在时为 sizeof...(Members)
+    template<auto M>
+    static constexpr std::size_t index_of(){
+        std::size_t index = sizeof...(Members), i = 0;
+        ((index = (index == sizeof...(Members) && same_member<M, Members>()) ? i : index, ++i), ...);
+        return index;
+    }
+
+    template<std::size_t... I>
+    void scatter(std::size_t i, const Prop& prop, std::index_sequence<I...>){
+        ((std::get<I>(columns)[i] = prop.*Members), ...);
+    }
+
+    template<std::size_t... I>
+    void gather(std::size_t i, Prop& prop, std::index_sequence<I...>) const {
+        ((prop.*Members = static_cast<typename member_pointer_traits<decltype(Members)>::value_type>(std::get<I>(columns)[i])), ...);
+    }
+
+public:
+    static constexpr std::size_t num_columns = whole ? 1 : sizeof...(Members);
+
+    PropertyColumns() = default;
+
+    explicit PropertyColumns(std::size_t n){
+        resize(n);
+    }
+
+    std::size_t size() const noexcept {return std::get<0>(columns).size();}
+    bool empty() const noexcept {return size() == 0;}
+
+    void resize(std::size_t n){
+        std::apply([n](auto&... column){(column.resize(n), ...);}, columns);
+    }
+
+    void reserve(std::size_t n){
+        std::apply([n](auto&... column){(column.reserve(n), ...);}, columns);
+    }
+
+    void clear() noexcept {
+        std::apply([](auto&... column){(column.clear(), ...);}, columns);
+    }
+
+    // 整列访问
+    template<std::size_t I>
+    auto& column() noexcept {return std::get<I>(columns);}
+    template<std::size_t I>
+    const auto& column() const noexcept {return std::get<I>(columns);}
+
+    template<auto M, typename = std::enable_if_t<std::is_member_object_pointer_v<decltype(M)>>>
+    auto& column() noexcept {
+        static_assert(!whole, "未拆分字段的列存储只有一列，请使用 column<0>()!");
+        constexpr std::size_t I = index_of<M>();
+        static_assert(I < sizeof...(Members), "该字段不在列存储中!");
+        return std::get<I>(columns);
+    }
+    template<auto M, typename = std::enable_if_t<std::is_member_object_pointer_v<decltype(M)>>>
+    const auto& column() const noexcept {
+        static_assert(!whole, "未拆分字段的列存储只有一列，请使用 column<0>()!");
+        constexpr std::size_t I = index_of<M>();
+        static_assert(I < sizeof...(Members), "该字段不在列存储中!");
+        return std::get<I>(columns);
+    }
+
+    // 单个元素
+    template<auto M>
+    auto& at(std::size_t i){
+        if (i >= size()) throw std::out_of_range("PropertyColumns::at(): 下标越界!");
+        return column<M>()[i];
+    }
+    template<auto M>
+    const auto& at(std::size_t i) const {
+        if (i >= size()) throw std::out_of_range("PropertyColumns::at(): 下标越界!");
+        return column<M>()[i];
+    }
+
+    // 第 i 行拼成一个 Prop，未列出的字段为默认值
+    Prop row(std::size_t i) const {
+        if (i >= size()) throw std::out_of_range("PropertyColumns::row(): 下标越界!");
+        if constexpr (whole) {
+            return std::get<0>(columns)[i];
+        } else {
+            static_assert(std::is_default_constructible_v<Prop>, "按行读取要求 Prop 可默认构造!");
+            Prop prop{};
+            gather(i, prop, std::index_sequence_for<decltype(Members)...>{});
+            return prop;
+        }
+    }
+
+    void assign(std::size_t i, const Prop& prop){
+        if (i >= size()) throw std::out_of_range("PropertyColumns::assign(): 下标越界!");
+        if constexpr (whole) std::get<0>(columns)[i] = prop;
+        else scatter(i, prop, std::index_sequence_for<decltype(Members)...>{});
+    }
+
+    void push_back(const Prop& prop){
+        std::size_t i = size();
+        resize(i + 1);
+        assign(i, prop);
+    }
+};
+
+// 顶点属性列，以稠密 id 为下标
+template<auto... Members, typename CSR>
+auto node_columns(const CSR& g, unsigned threads = 1){
+    using Prop = typename CSR::node_prop_type;
+    static_assert(!std::is_void_v<Prop>, "此图不存在顶点属性!");
+    using id_type = typename CSR::id_type;
+    PropertyColumns<Prop, Members...> columns(g.num_nodes());
+    parallel_for(g.num_nodes(), threads == 0 ? 1 : threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t v = begin; v < end; ++v) columns.assign(v, g.node_prop(static_cast<id_type>(v)));
+    }, 4096);
+    return columns;
+}
+
+// 出边属性列，以出边偏移为下标
+template<auto... Members, typename CSR>
+auto edge_columns(const CSR& g, unsigned threads = 1){
+    using Prop = typename CSR::edge_prop_type;
+    static_assert(!std::is_void_v<Prop>, "此图不存在边属性!");
+    using id_type = typename CSR::id_type;
+    const id_type n = g.num_nodes();
+
+    // 每行的起始偏移：CompressedGraph 等没有 offsets() 的图按出度前缀和计算
+    std::vector<typename CSR::offset_type> start(static_cast<std::size_t>(n) + 1, 0);
+    for (id_type u = 0; u < n; ++u) start[u + 1] = start[u] + g.out_degree(u);
+
+    PropertyColumns<Prop, Members...> columns(start[n]);
+    parallel_for(n, threads == 0 ? 1 : threads, [&](std::size_t begin, std::size_t end, unsigned){
+        for (std::size_t u = begin; u < end; ++u) {
+            std::size_t e = start[u];
+            for (const auto& prop : g.out_edge_props(static_cast<id_type>(u))) columns.assign(e++, prop);
+        }
+    }, 1024);
+    return columns;
+}
+
+#endif
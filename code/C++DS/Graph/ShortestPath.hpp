@@ -0,0 +1,239 @@
+#ifndef SHORTESTPATH_HPP
+#define SHORTESTPATH_HPP
+
+#include "Graph.hpp"
+#include "GraphParallel.hpp"
+#include "../Tree/IndexedPriorityQueue.hpp"
+#include <cmath>
+#include <map>
+
+/**
+ * @file ShortestPath.hpp
+ * @brief 带权图的单源最短路，运行在 CSRGraph / MappedGraph 上，边权来自边属性。
+ *
+ * 1. dijkstra(g, source, weight):
+ *    - 串行 Dijkstra，用 IndexedPriorityQueue 做 decrease-key，每个顶点至多在堆中出现一次。
+ *
+ * 2. delta_stepping(g, source, delta, weight, threads):
+ *    - 并行 delta-stepping。按 floor(dist / delta) 分桶，同一个桶内的轻边(w <= delta)反复松弛直到桶空，
+ *      桶清空后再一次性松弛这一批顶点的重边。松弛用 CAS 原子取 min，多个线程可同时处理一个桶。
+ *    - 只保存非空的桶(以桶号为键的有序表)，空桶直接跳过，内存与外层循环次数只取决于入桶次数，与最大距离 / delta 无关。
+ *    - parent 在距离收敛后从源点沿紧边(dist[u] + w == dist[v])逐层扩展得到，构成一棵以源点为根的树，
+ *      即使存在零权环也不会成环。
+ *
+ * weight 是边属性到边权的投影，例如 [](const Road& r){return r.length;}；
+ * 边属性本身就是数值时可以省略。边权不能为负，否则抛出 std::invalid_argument。
+ * 结果以 CSR 的稠密 id 为下标，不可达顶点的距离为 std::numeric_limits<W>::max()，parent 为 npos。
+ */
+
+// 默认边权投影：边属性本身就是边权
+struct IdentityWeight {
+    template<typename P>
+    const P& operator()(const P& prop) const noexcept {return prop;}
+};
+
+template<typename CSR, typename WeightFn>
+using edge_weight_t = std::decay_t<std::invoke_result_t<WeightFn, const typename CSR::edge_prop_type&>>;
+
+template<typename IdType, typename W>
+struct ShortestPathResult {
+    IdType source;
+    std::vector<W> distance;
+    std::vector<IdType> parent;
+
+    static constexpr W unreachable = std::numeric_limits<W>::max();
+
+    bool reachable(IdType v) const {return distance[v] != unreachable;}
+
+    // 源点到 v 的路径(含两端)，不可达返回空
+    std::vector<IdType> path_to(IdType v) const {
+        std::vector<IdType> path;
+        if (!reachable(v)) return path;
+        for (IdType cur = v; ; cur = parent[cur]) {
+            path.emplace_back(cur);
+            if (cur == source) break;
+            if (parent[cur] >= parent.size() || path.size() > parent.size())
+                throw std::logic_error("ShortestPathResult::path_to(): parent 不构成以源点为根的树!");
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+template<typename CSR, typename WeightFn = IdentityWeight>
+ShortestPathResult<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>
+dijkstra(const CSR& g, typename CSR::id_type source, WeightFn weight = {}){
+    using id_type = typename CSR::id_type;
+    using W = edge_weight_t<CSR, WeightFn>;
+    static_assert(std::is_arithmetic_v<W>, "边权必须是数值类型!");
+    constexpr W inf = std::numeric_limits<W>::max();
+
+    const id_type n = g.num_nodes();
+    if (source >= n) throw std::out_of_range("dijkstra(): 源点不存在!");
+
+    ShortestPathResult<id_type, W> result{source, std::vector<W>(n, inf), std::vector<id_type>(n, CSR::npos)};
+    auto& dist = result.distance;
+    auto& parent = result.parent;
+    std::vector<char> settled(n, 0);
+    IndexedPriorityQueue<W> heap(n);
+
+    dist[source] = 0;
+    parent[source] = source;
+    heap.push(source, 0);
+    while (!heap.isEmpty()) {
+        id_type u = static_cast<id_type>(heap.getTopIndex());
+        W du = heap.getTopKey();
+        heap.pop();
+        settled[u] = 1;
+        auto prop = g.out_edge_props(u).begin();
+        for (id_type v : g.out_neighbors(u)) {
+            const auto& p = *prop++;
+            if (settled[v]) continue;
+            W w = weight(p);
+            if (w < W(0)) throw std::invalid_argument("dijkstra(): 存在负权边!");
+            W nd = du + w;
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                heap.pushOrDecrease(v, nd);
+            }
+        }
+    }
+    return result;
+}
+
+
+template<typename CSR, typename WeightFn = IdentityWeight>
+ShortestPathResult<typename CSR::id_type, edge_weight_t<CSR, WeightFn>>
+delta_stepping(const CSR& g, typename CSR::id_type source, edge_weight_t<CSR, WeightFn> delta,
+    WeightFn weight = {}, unsigned threads = hardware_threads()){
+    using id_type = typename CSR::id_type;
+    using W = edge_weight_t<CSR, WeightFn>;
+    static_assert(std::is_arithmetic_v<W>, "边权必须是数值类型!");
+    constexpr W inf = std::numeric_limits<W>::max();
+
+    const id_type n = g.num_nodes();
+    if (source >= n) throw std::out_of_range("delta_stepping(): 源点不存在!");
+    if (!(delta > W(0))) throw std::invalid_argument("delta_stepping(): delta 必须为正!");
+    if (threads == 0) threads = 1;
+
+    std::vector<std::atomic<W>> dist(n);
+    for (id_type v = 0; v < n; ++v) dist[v].store(inf, std::memory_order_relaxed);
+    dist[source].store(0, std::memory_order_relaxed);
+
+    // 桶号保持为 W 类型：浮点距离很大时转成整数会溢出
+    auto bucket_of = [delta](W d) -> W {
+        if constexpr (std::is_integral_v<W>) return d / delta;
+        else return std::floor(d / delta);
+    };
+
+    // 原子取 min，返回是否更新
+    auto relax = [&dist](id_type v, W nd){
+        W cur = dist[v].load(std::memory_order_relaxed);
+        while (nd < cur) {
+            if (dist[v].compare_exchange_weak(cur, nd, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    };
+
+    // 只保存非空的桶，按桶号有序，处理完一个桶后直接跳到下一个非空桶；桶的数量不超过入桶次数
+    std::map<W, std::vector<id_type>> buckets;
+    buckets[W(0)].emplace_back(source);
+    std::vector<std::vector<id_type>> local(threads);
+    std::atomic<bool> negative{false};
+
+    // 并行松弛 frontier 中顶点的轻边或重边，更新成功的顶点按新桶号放回 buckets
+    auto relax_frontier = [&](const std::vector<id_type>& frontier, bool light){
+        for (auto& l : local) l.clear();
+        parallel_for(frontier.size(), threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+            auto& out = local[tid];
+            for (std::size_t i = begin; i < end; ++i) {
+                id_type u = frontier[i];
+                W du = dist[u].load(std::memory_order_relaxed);
+                auto prop = g.out_edge_props(u).begin();
+                for (id_type v : g.out_neighbors(u)) {
+                    W w = weight(*prop++);
+                    if (w < W(0)) {
+                        negative.store(true, std::memory_order_relaxed);
+                        continue;
+                    }
+                    if ((w <= delta) != light) continue;
+                    if (relax(v, du + w)) out.emplace_back(v);
+                }
+            }
+        }, 256);
+        for (auto& l : local) {
+            for (id_type v : l) {
+                buckets[bucket_of(dist[v].load(std::memory_order_relaxed))].emplace_back(v);
+            }
+        }
+    };
+
+    std::vector<id_type> frontier, settled;
+    std::vector<char> in_settled(n, 0);
+    while (!buckets.empty()) {
+        const W i = buckets.begin()->first;
+        settled.clear();
+        // 轻边松弛只会把顶点放回当前桶或更靠后的桶，当前桶反复取出直到为空
+        for (auto current = buckets.begin(); current != buckets.end() && current->first == i; current = buckets.find(i)) {
+            frontier.clear();
+            frontier.swap(current->second);
+            buckets.erase(current);
+            // 过滤已经移到更小桶里的陈旧项，并去重
+            std::sort(frontier.begin(), frontier.end());
+            frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+            frontier.erase(std::remove_if(frontier.begin(), frontier.end(), [&](id_type v){
+                return bucket_of(dist[v].load(std::memory_order_relaxed)) != i;
+            }), frontier.end());
+            for (id_type v : frontier) {
+                if (!in_settled[v]) {
+                    in_settled[v] = 1;
+                    settled.emplace_back(v);
+                }
+            }
+            relax_frontier(frontier, true);
+        }
+        relax_frontier(settled, false);
+        for (id_type v : settled) in_settled[v] = 0;
+        if (negative.load(std::memory_order_relaxed)) throw std::invalid_argument("delta_stepping(): 存在负权边!");
+    }
+
+    ShortestPathResult<id_type, W> result{source, std::vector<W>(n), std::vector<id_type>(n, CSR::npos)};
+    for (id_type v = 0; v < n; ++v) result.distance[v] = dist[v].load(std::memory_order_relaxed);
+
+    // 从源点沿紧边(dist[u] + w(u,v) == dist[v])逐层扩展，v 在第一次被发现的那一层确定 parent
+    // parent 总是更早一层的顶点，零权环上的顶点不会互为 parent；同层多个候选取 id 最小者，结果与线程数无关
+    std::vector<std::atomic<id_type>> parent(n);
+    for (id_type v = 0; v < n; ++v) parent[v].store(CSR::npos, std::memory_order_relaxed);
+    parent[source].store(source, std::memory_order_relaxed);
+    std::vector<char> found(n, 0); // 在之前各层(含当前层)中已确定 parent 的顶点
+    std::vector<id_type> level{source};
+    while (!level.empty()) {
+        for (id_type v : level) found[v] = 1;
+        for (auto& l : local) l.clear();
+        parallel_for(level.size(), threads, [&](std::size_t begin, std::size_t end, unsigned tid){
+            auto& out = local[tid];
+            for (std::size_t i = begin; i < end; ++i) {
+                id_type u = level[i];
+                W du = result.distance[u];
+                auto prop = g.out_edge_props(u).begin();
+                for (id_type v : g.out_neighbors(u)) {
+                    const auto& p = *prop++;
+                    if (found[v] || du + weight(p) != result.distance[v]) continue;
+                    id_type cur = CSR::npos;
+                    if (parent[v].compare_exchange_strong(cur, u, std::memory_order_relaxed)) {
+                        out.emplace_back(v);
+                        continue;
+                    }
+                    while (u < cur && !parent[v].compare_exchange_weak(cur, u, std::memory_order_relaxed)) {}
+                }
+            }
+        }, 256);
+        level.clear();
+        for (auto& l : local) level.insert(level.end(), l.begin(), l.end());
+    }
+    for (id_type v = 0; v < n; ++v) result.parent[v] = parent[v].load(std::memory_order_relaxed);
+    return result;
+}
+
+#endif
@@ -0,0 +1,412 @@
+#ifndef UPDATELOGGRAPH_HPP
+#define UPDATELOGGRAPH_HPP
+
+#include "Graph.hpp"
+#include <future>
+#include <numeric>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+/**
+ * @file UpdateLogGraph.hpp
+ * @brief 带追加式更新日志(update log)的动态图：写入只追加日志，读取合并基图与日志，后台按有序批次压实(compaction)。
+ *
+ * 流式的插入/删除逐条调用 Graph 的 add_edge / remove_edge，每次都是对哈希容器的随机修改。
+ * UpdateLogGraph 把写入与修改基图分开：
+ *
+ * 1. 写入：add_node / add_edge / remove_* 只在活动日志(active)末尾追加一条记录并登记到顶点索引，
+ *    写延迟与基图规模无关。活动日志达到 compact_threshold 条时自动触发一次后台压实。
+ *
+ * 2. 读取(合并视图)：has_node / has_edge / node_prop 先查基图，再按提交顺序重放日志中涉及这些顶点的记录，
+ *    结果与把日志逐条应用到基图上之后再查询完全一致。每段日志维护 顶点 -> 记录位置(升序) 的索引，
+ *    写入时顺带登记，读取只重放被查询顶点的记录(has_edge 把两端的位置表归并去重)，代价与这些顶点的日志条数成正比。
+ *
+ * 3. 压实：compact() 先把活动日志整体封存(sealed，封存期间读者仍会重放它，新写入进入新的活动日志)，
+ *    再把它应用到基图：
+ *    - 顶点操作作为分界，把日志切成若干段，段内只有边操作，而顶点集合不变时不同边上的操作互相可交换；
+ *    - 段内按规范化的边键(无向图为 (小, 大))稳定排序，同一条边的操作保持提交顺序；
+ *      remove_edge 删除该键上的全部边，因此每个键只需在最后一次删除处删一次，其后的加边与其它键的加边
+ *      合并成一次 add_edges 批量插入(按源点分组、组内顺序写入)；
+ *    - 封存的日志按 apply_chunk 条一块依次应用(块边界只是日志顺序上的切分，段内排序在块内进行)，
+ *      每块独占基图写锁，并在同一临界区内推进已应用位置 sealed_applied，读者只重放封存日志中该位置之后的记录，
+ *      因此不会看到重复或缺失的记录；读者最多等待一块的应用时间，而不是整次压实。
+ *    compact_async() 在后台线程中执行 compact()，同一时刻只有一个压实任务。
+ *
+ * 锁的顺序：读者先取基图读锁再取日志读锁；压实者封存时只取日志写锁，应用每块时先取基图写锁再取日志写锁；
+ * 写者只取日志写锁。写操作的返回值要在应用时才能确定，因此写接口不返回插入/删除的条数。
+ * 不支持 remove_edge_with_prop：它的效果取决于基图中的边属性，无法只凭日志在合并视图中重放。
+ */
+
+template<typename NodeType=int, typename NodePropType=void, typename EdgePropType=void,
+    EdgeDirection edge_direction=EdgeDirection::UNDIRECTED,
+    MultiEdge multi_edge=MultiEdge::DISALLOWED,
+    SelfLoop self_loop=SelfLoop::DISALLOWED,
+    Map adj_list_spec=Map::UNORDERED_MAP,
+    Container neighbors_container_spec=Container::UNORDERED_SET,
+    InEdgeIndex in_edge_index=InEdgeIndex::NONE>
+class UpdateLogGraph{
+public:
+    using Base = Graph<NodeType, NodePropType, EdgePropType, edge_direction, multi_edge, self_loop,
+        adj_list_spec, neighbors_container_spec, in_edge_index>;
+    using Frozen = typename Base::Frozen;
+
+private:
+    using NodePropArg = std::conditional_t<std::is_void_v<NodePropType>, empty_node_prop, NodePropType>;
+    using EdgePropArg = std::conditional_t<std::is_void_v<EdgePropType>, empty_edge_prop, EdgePropType>;
+
+    enum class OpKind {ADD_NODE, REMOVE_NODE, ADD_EDGE, REMOVE_EDGE};
+
+    struct Op {
+        OpKind kind;
+        NodeType out;
+        NodeType in;   // 顶点操作中与 out 相同
+        std::optional<NodePropArg> node_prop;
+        std::optional<EdgePropArg> edge_prop;
+    };
+    using Positions = std::vector<std::size_t>;
+    using Index = typename AdjListSelector<adj_list_spec, NodeType, Positions>::type;
+
+    // 一段日志及其按顶点的位置索引
+    struct Log {
+        std::vector<Op> ops;
+        Index by_node;
+
+        void push(Op op){
+            std::size_t pos = ops.size();
+            by_node[op.out].emplace_back(pos);
+            if (op.in != op.out) by_node[op.in].emplace_back(pos);
+            ops.emplace_back(std::move(op));
+        }
+        std::size_t size() const noexcept {return ops.size();}
+        bool empty() const noexcept {return ops.empty();}
+    };
+
+    mutable std::shared_mutex base_mutex;
+    Base graph;
+
+    mutable std::shared_mutex log_mutex;
+    Log active;
+    std::shared_ptr<const Log> sealed; // 正在压实、尚未并入基图的日志
+    std::size_t sealed_applied = 0;    // sealed 中已经应用到基图的前缀长度
+
+    static constexpr std::size_t apply_chunk = std::size_t(1) << 14; // 压实时每次持有基图写锁应用的最大条数
+
+    std::mutex compact_mutex;        // 同一时刻只有一个压实者
+    std::mutex background_mutex;
+    std::future<std::size_t> background;
+
+    std::size_t compact_threshold;
+    unsigned compact_threads;
+
+    static constexpr bool directed = edge_direction == EdgeDirection::DIRECTED;
+
+    // 规范化的边键：无向图端点按 (小, 大) 排列
+    static std::pair<const NodeType*, const NodeType*> edge_key(const Op& op){
+        if constexpr (!directed) {
+            if (op.in < op.out) return {&op.in, &op.out};
+        }
+        return {&op.out, &op.in};
+    }
+
+    static bool same_edge(const Op& op, const NodeType& u, const NodeType& v){
+        if (op.out == u && op.in == v) return true;
+        if constexpr (!directed) return op.out == v && op.in == u;
+        return false;
+    }
+
+    void enqueue(Op op){
+        bool full;
+        {
+            std::unique_lock<std::shared_mutex> lock(log_mutex);
+            active.push(std::move(op));
+            full = active.size() >= compact_threshold;
+        }
+        if (full) compact_async();
+    }
+
+    // 按提交顺序对 log 中位置不小于 from、且涉及 u 或 v 的记录调用 f
+    template<typename F>
+    static void replay_log(const Log& log, std::size_t from, const NodeType& u, const NodeType& v, F& f){
+        static const Positions none;
+        auto positions = [&](const NodeType& node) -> const Positions& {
+            auto it = log.by_node.find(node);
+            return it == log.by_node.end() ? none : it->second;
+        };
+        const Positions& a = positions(u);
+        const Positions& b = (u == v) ? none : positions(v);
+        auto i = std::lower_bound(a.begin(), a.end(), from), j = std::lower_bound(b.begin(), b.end(), from);
+        while (i != a.end() || j != b.end()) {
+            std::size_t pos;
+            if (j == b.end() || (i != a.end() && *i < *j)) pos = *i++;
+            else if (i == a.end() || *j < *i) pos = *j++;
+            else {
+                pos = *i++;
+                ++j;
+            }
+            f(log.ops[pos]);
+        }
+    }
+
+    // 依次重放封存日志(未应用部分)和活动日志中涉及 u 或 v 的记录，调用方持有日志读锁
+    template<typename F>
+    void replay(const NodeType& u, const NodeType& v, F&& f) const {
+        if (sealed) replay_log(*sealed, sealed_applied, u, v, f);
+        replay_log(active, 0, u, v, f);
+    }
+
+    // 把一段只含边操作的日志应用到基图，调用方持有基图写锁
+    void apply_edges(const std::vector<Op>& log, std::size_t first, std::size_t last, unsigned threads){
+        std::vector<std::size_t> order(last - first);
+        std::iota(order.begin(), order.end(), first);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b){
+            auto ka = edge_key(log[a]), kb = edge_key(log[b]);
+            if (*ka.first < *kb.first) return true;
+            if (*kb.first < *ka.first) return false;
+            return *ka.second < *kb.second;
+        });
+
+        std::vector<std::pair<NodeType,NodeType>> edges;
+        std::vector<std::tuple<NodeType,NodeType,EdgePropArg>> prop_edges;
+        for (std::size_t g = 0; g < order.size();) {
+            auto key = edge_key(log[order[g]]);
+            std::size_t h = g, last_remove = order.size();
+            while (h < order.size()) {
+                auto k = edge_key(log[order[h]]);
+                if (*key.first < *k.first || *k.first < *key.first || *key.second < *k.second || *k.second < *key.second) break;
+                if (log[order[h]].kind == OpKind::REMOVE_EDGE) last_remove = h;
+                ++h;
+            }
+            std::size_t adds = g;
+            if (last_remove != order.size()) {
+                const Op& op = log[order[last_remove]];
+                graph.remove_edge(op.out, op.in);
+                adds = last_remove + 1;
+            }
+            for (std::size_t i = adds; i < h; ++i) {
+                const Op& op = log[order[i]];
+                if constexpr (std::is_void_v<EdgePropType>) edges.emplace_back(op.out, op.in);
+                else prop_edges.emplace_back(op.out, op.in, *op.edge_prop);
+            }
+            g = h;
+        }
+        if constexpr (std::is_void_v<EdgePropType>) {
+            if (!edges.empty()) graph.add_edges(edges, threads);
+        } else {
+            if (!prop_edges.empty()) graph.add_edges_with_prop(prop_edges, threads);
+        }
+    }
+
+    // 把 log[first, last) 应用到基图，调用方持有基图写锁
+    void apply(const std::vector<Op>& log, std::size_t first, std::size_t last, unsigned threads){
+        std::size_t segment = first;
+        for (std::size_t i = first; i <= last; ++i) {
+            if (i < last && (log[i].kind == OpKind::ADD_EDGE || log[i].kind == OpKind::REMOVE_EDGE)) continue;
+            if (segment < i) apply_edges(log, segment, i, threads);
+            segment = i + 1;
+            if (i == last) break;
+            const Op& op = log[i];
+            if (op.kind == OpKind::REMOVE_NODE) {
+                graph.remove_node(op.out);
+            } else if constexpr (std::is_void_v<NodePropType>) {
+                graph.add_node(op.out);
+            } else {
+                graph.add_node_with_prop(op.out, *op.node_prop);
+            }
+        }
+    }
+
+public:
+    explicit UpdateLogGraph(Base initial = Base(), std::size_t compact_threshold = std::size_t(1) << 16, unsigned compact_threads = 1)
+        : graph(std::move(initial)), compact_threshold(compact_threshold == 0 ? 1 : compact_threshold), compact_threads(compact_threads) {}
+
+    UpdateLogGraph(const UpdateLogGraph&) = delete;
+    UpdateLogGraph& operator=(const UpdateLogGraph&) = delete;
+
+    ~UpdateLogGraph(){
+        wait();
+    }
+
+    // 添加无属性结点
+    void add_node(const NodeType& node){
+        static_assert((std::is_same_v<NodePropType,void>),"此图必须添加顶点属性!");
+        enqueue(Op{OpKind::ADD_NODE, node, node, std::nullopt, std::nullopt});
+    }
+
+    template<typename... Args>
+    void add_node(const NodeType& node, const Args&... rest_nodes){
+        static_assert((std::is_convertible_v<Args, NodeType> && ...), "所有结点必须为NodeType类型!");
+        add_node(node);
+        (add_node(rest_nodes), ...);
+    }
+
+    // 添加有属性顶点
+    void add_node_with_prop(const NodeType& node, const NodePropArg& nodeprop){
+        static_assert(!(std::is_same_v<NodePropType,void>),"此图不能添加顶点属性!");
+        enqueue(Op{OpKind::ADD_NODE, node, node, nodeprop, std::nullopt});
+    }
+
+    // 添加无属性边
+    void add_edge(const NodeType& outnode, const NodeType& innode){
+        static_assert((std::is_same_v<EdgePropType,void>),"此图必须添加边属性!");
+        enqueue(Op{OpKind::ADD_EDGE, outnode, innode, std::nullopt, std::nullopt});
+    }
+
+    // 添加有属性边
+    void add_edge_with_prop(const NodeType& outnode, const NodeType& innode, const EdgePropArg& edgeprop){
+        static_assert(!(std::is_same_v<EdgePropType,void>),"此图不能添加边属性!");
+        enqueue(Op{OpKind::ADD_EDGE, outnode, innode, std::nullopt, edgeprop});
+    }
+
+    // 一次加锁追加一批边
+    void add_edges(const std::vector<std::pair<NodeType,NodeType>>& edges){
+        static_assert((std::is_same_v<EdgePropType,void>),"此图必须添加边属性!");
+        bool full;
+        {
+            std::unique_lock<std::shared_mutex> lock(log_mutex);
+            for (auto& [u, v] : edges) active.push(Op{OpKind::ADD_EDGE, u, v, std::nullopt, std::nullopt});
+            full = active.size() >= compact_threshold;
+        }
+        if (full) compact_async();
+    }
+
+    void add_edges_with_prop(const std::vector<std::tuple<NodeType,NodeType,EdgePropArg>>& edges){
+        static_assert(!(std::is_same_v<EdgePropType,void>),"此图不能添加边属性!");
+        bool full;
+        {
+            std::unique_lock<std::shared_mutex> lock(log_mutex);
+            for (auto& [u, v, p] : edges) active.push(Op{OpKind::ADD_EDGE, u, v, std::nullopt, p});
+            full = active.size() >= compact_threshold;
+        }
+        if (full) compact_async();
+    }
+
+    // 删除结点
+    void remove_node(const NodeType& node){
+        enqueue(Op{OpKind::REMOVE_NODE, node, node, std::nullopt, std::nullopt});
+    }
+
+    // 删除边(重复边全部删除，与 Graph::remove_edge 相同)
+    void remove_edge(const NodeType& outnode, const NodeType& innode){
+        enqueue(Op{OpKind::REMOVE_EDGE, outnode, innode, std::nullopt, std::nullopt});
+    }
+
+    // 合并视图：查找结点
+    bool has_node(const NodeType& node) const {
+        std::shared_lock<std::shared_mutex> base_lock(base_mutex);
+        bool present = graph.has_node(node);
+        std::shared_lock<std::shared_mutex> log_lock(log_mutex);
+        replay(node, node, [&](const Op& op){
+            if (op.out != node) return;
+            if (op.kind == OpKind::ADD_NODE) present = true;
+            else if (op.kind == OpKind::REMOVE_NODE) present = false;
+        });
+        return present;
+    }
+
+    // 合并视图：顶点属性的拷贝，顶点不存在时为空
+    std::optional<NodePropArg> node_prop(const NodeType& node) const {
+        static_assert(!(std::is_same_v<NodePropType,void>),"此图不存在顶点属性!");
+        std::shared_lock<std::shared_mutex> base_lock(base_mutex);
+        std::optional<NodePropArg> prop;
+        if (auto info = graph.find_node(node)) prop = *info->prop;
+        std::shared_lock<std::shared_mutex> log_lock(log_mutex);
+        replay(node, node, [&](const Op& op){
+            if (op.out != node) return;
+            if (op.kind == OpKind::ADD_NODE && !prop) prop = op.node_prop;
+            else if (op.kind == OpKind::REMOVE_NODE) prop.reset();
+        });
+        return prop;
+    }
+
+    // 合并视图：边的条数，与 Graph::has_edge 相同
+    int has_edge(const NodeType& outnode, const NodeType& innode) const {
+        std::shared_lock<std::shared_mutex> base_lock(base_mutex);
+        bool has_out = graph.has_node(outnode), has_in = graph.has_node(innode);
+        int count = graph.has_edge(outnode, innode);
+        std::shared_lock<std::shared_mutex> log_lock(log_mutex);
+        replay(outnode, innode, [&](const Op& op){
+            switch (op.kind) {
+                case OpKind::ADD_NODE:
+                    if (op.out == outnode) has_out = true;
+                    if (op.out == innode) has_in = true;
+                    break;
+                case OpKind::REMOVE_NODE:
+                    if (op.out == outnode || op.out == innode) {
+                        if (op.out == outnode) has_out = false;
+                        if (op.out == innode) has_in = false;
+                        count = 0;
+                    }
+                    break;
+                case OpKind::ADD_EDGE:
+                    if (!has_out || !has_in || !same_edge(op, outnode, innode)) break;
+                    if constexpr (self_loop == SelfLoop::DISALLOWED) {
+                        if (outnode == innode) break;
+                    }
+                    if constexpr (multi_edge == MultiEdge::DISALLOWED) {
+                        if (count > 0) break;
+                    }
+                    ++count;
+                    break;
+                case OpKind::REMOVE_EDGE:
+                    if (has_out && has_in && same_edge(op, outnode, innode)) count = 0;
+                    break;
+            }
+        });
+        return count;
+    }
+
+    // 尚未并入基图的日志条数(含正在压实的部分)
+    std::size_t pending() const {
+        std::shared_lock<std::shared_mutex> lock(log_mutex);
+        return active.size() + (sealed ? sealed->size() - sealed_applied : 0);
+    }
+
+    // 封存当前活动日志并应用到基图，返回应用的日志条数
+    std::size_t compact(unsigned threads = 1){
+        std::lock_guard<std::mutex> lock(compact_mutex);
+        std::shared_ptr<const Log> batch;
+        {
+            std::unique_lock<std::shared_mutex> log_lock(log_mutex);
+            if (active.empty()) return 0;
+            batch = std::make_shared<const Log>(std::move(active));
+            active = Log();
+            sealed = batch;
+            sealed_applied = 0;
+        }
+        const auto& ops = batch->ops;
+        for (std::size_t first = 0; first < ops.size(); first += apply_chunk) {
+            std::size_t last = std::min(ops.size(), first + apply_chunk);
+            std::unique_lock<std::shared_mutex> base_lock(base_mutex);
+            apply(ops, first, last, threads);
+            std::unique_lock<std::shared_mutex> log_lock(log_mutex);
+            sealed_applied = last;
+            if (last == ops.size()) sealed.reset();
+        }
+        return ops.size();
+    }
+
+    // 在后台线程中压实；已有压实任务在运行时不重复启动，返回是否启动了新任务
+    bool compact_async(){
+        std::lock_guard<std::mutex> lock(background_mutex);
+        if (background.valid() && background.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+        background = std::async(std::launch::async, [this]{return compact(compact_threads);});
+        return true;
+    }
+
+    // 等待后台压实任务结束
+    void wait(){
+        std::lock_guard<std::mutex> lock(background_mutex);
+        if (background.valid()) background.get();
+    }
+
+    // 压实全部日志后冻结基图
+    Frozen freeze(unsigned threads = 1){
+        wait();
+        compact(threads);
+        std::shared_lock<std::shared_mutex> lock(base_mutex);
+        return graph.freeze();
+    }
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef INDEXEDPRIORITYQUEUE_HPP
+#define INDEXEDPRIORITYQUEUE_HPP
+
+#include <iostream>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @file IndexedPriorityQueue.hpp
+ * @brief 支持按下标修改优先级(decrease-key)的二叉堆。
+ *
+ * 元素是 [0, capacity) 范围内的整数下标，每个下标最多在堆中出现一次，
+ * pos 数组记录下标在堆中的位置，因此 decreaseKey / contains 都不需要查找。
+ * 常用于 Dijkstra、Prim 等需要松弛操作的图算法，避免 std::priority_queue 的重复入队。
+ *
+ * clear() 只重置当前仍在堆中的下标，复用同一个堆做多次查询时不需要 O(capacity) 的重新初始化。
+ */
+
+template <typename Key, typename Comparator = std::less<Key>>
+class IndexedPriorityQueue{
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    std::vector<std::pair<Key, std::size_t>> heap; // (key, index)
+    std::vector<std::size_t> pos;                  // index -> 在 heap 中的位置，不在堆中为 npos
+    Comparator comp;
+
+    void place(std::size_t i, std::pair<Key, std::size_t>&& item){
+        pos[item.second] = i;
+        heap[i] = std::move(item);
+    }
+
+    void siftUp(std::size_t i){
+        auto item = std::move(heap[i]);
+        while (i > 0) {
+            std::size_t parent = (i - 1) / 2;
+            if (!comp(item.first, heap[parent].first)) break;
+            place(i, std::move(heap[parent]));
+            i = parent;
+        }
+        place(i, std::move(item));
+    }
+
+    void siftDown(std::size_t i){
+        auto item = std::move(heap[i]);
+        const std::size_t n = heap.size();
+        while (true) {
+            std::size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && comp(heap[child + 1].first, heap[child].first)) ++child;
+            if (!comp(heap[child].first, item.first)) break;
+            place(i, std::move(heap[child]));
+            i = child;
+        }
+        place(i, std::move(item));
+    }
+
+public:
+    IndexedPriorityQueue(std::size_t capacity = 0) : pos(capacity, npos), comp() {}
+
+    // 扩大下标范围
+    void resize(std::size_t capacity){
+        if (capacity > pos.size()) pos.resize(capacity, npos);
+    }
+
+    std::size_t capacity() const noexcept {return pos.size();}
+    std::size_t getSize() const noexcept {return heap.size();}
+    bool isEmpty() const noexcept {return heap.empty();}
+    bool contains(std::size_t index) const {return index < pos.size() && pos[index] != npos;}
+
+    const Key& keyOf(std::size_t index) const {
+        if (!contains(index)) throw std::out_of_range("IndexedPriorityQueue::keyOf(): index is not in queue!");
+        return heap[pos[index]].first;
+    }
+
+    void push(std::size_t index, const Key& key){
+        if (index >= pos.size()) throw std::out_of_range("IndexedPriorityQueue::push(): index out of range!");
+        if (pos[index] != npos) throw std::invalid_argument("IndexedPriorityQueue::push(): index already in queue!");
+        heap.emplace_back(key, index);
+        pos[index] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+    }
+
+    void decreaseKey(std::size_t index, const Key& key){
+        if (!contains(index)) throw std::out_of_range("IndexedPriorityQueue::decreaseKey(): index is not in queue!");
+        std::size_t i = pos[index];
+        if (comp(heap[i].first, key)) throw std::invalid_argument("IndexedPriorityQueue::decreaseKey(): new key is worse!");
+        heap[i].first = key;
+        siftUp(i);
+    }
+
+    // 不在堆中则插入，在堆中且新优先级更高则 decrease-key，返回是否发生了修改
+    bool pushOrDecrease(std::size_t index, const Key& key){
+        if (index >= pos.size()) throw std::out_of_range("IndexedPriorityQueue::pushOrDecrease(): index out of range!");
+        if (pos[index] == npos) {
+            push(index, key);
+            return true;
+        }
+        std::size_t i = pos[index];
+        if (!comp(key, heap[i].first)) return false;
+        heap[i].first = key;
+        siftUp(i);
+        return true;
+    }
+
+    std::size_t getTopIndex() const {
+        if (heap.empty()) throw std::underflow_error("IndexedPriorityQueue::getTopIndex(): IndexedPriorityQueue is empty!");
+        return heap[0].second;
+    }
+
+    const Key& getTopKey() const {
+        if (heap.empty()) throw std::underflow_error("IndexedPriorityQueue::getTopKey(): IndexedPriorityQueue is empty!");
+        return heap[0].first;
+    }
+
+    void pop(){
+        if (heap.empty()) throw std::underflow_error("IndexedPriorityQueue::pop(): IndexedPriorityQueue is empty!");
+        pos[heap[0].second] = npos;
+        if (heap.size() > 1) {
+            heap[0] = std::move(heap.back());
+            heap.pop_back();
+            pos[heap[0].second] = 0;
+            siftDown(0);
+        } else {
+            heap.pop_back();
+        }
+    }
+
+    void clear() noexcept {
+        for (auto& item : heap) pos[item.second] = npos;
+        heap.clear();
+    }
+};
+
+#endif
@@ -413,7 +413,7 @@ SetHandle<T> UnionFind<T, Hasher>::Find(const T& element){
 
 // 特化UnionFind函数定义
 
-UnionFind<int>::UnionFind(int size){ 
+inline UnionFind<int>::UnionFind(int size){ 
     parent.resize(size);
     rank.resize(size,0);
     for(int i=0;i<size;++i) {
@@ -421,7 +421,7 @@ UnionFind<int>::UnionFind(int size){
     }
 }
 
-void UnionFind<int>::resize(int size){
+inline void UnionFind<int>::resize(int size){
     int sz=parent.size();
     parent.resize(size);
     rank.resize(size);
@@ -431,7 +431,7 @@ void UnionFind<int>::resize(int size){
     }
 }
 
-int UnionFind<int>::Find(int x){
+inline int UnionFind<int>::Find(int x){
     int root = x;
     while (parent[root] != root) {
         root = parent[root];
@@ -444,7 +444,7 @@ int UnionFind<int>::Find(int x){
     return root;
 }
 
-void UnionFind<int>::Union(int x, int y){
+inline void UnionFind<int>::Union(int x, int y){
     int rootX = Find(x); //找到x和y的根节点
     int rootY = Find(y);
     if (rootX == rootY) return; //如果已经在同一个集合中，无需合并
@@ -458,7 +458,7 @@ void UnionFind<int>::Union(int x, int y){
     }
 }
 
-bool UnionFind<int>::isConnected(int x,int y){
+inline bool UnionFind<int>::isConnected(int x,int y){
     return Find(x)==Find(y);
 }
 